@@ -0,0 +1,351 @@
+#include "AllocationProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+namespace DotNetNative
+{
+    namespace
+    {
+        constexpr size_t ShardCapacity = 1024;
+        constexpr const char *UnknownFileName = "<unknown>";
+
+        struct Entry
+        {
+            std::atomic<const char*> m_fileName;
+            std::atomic<int>         m_lineNumber;
+            std::atomic<uint64_t>    m_sampleCount;
+            std::atomic<uint64_t>    m_allocationCount;
+            std::atomic<uint64_t>    m_allocatedBytes;
+        };
+
+        // One open-addressing table per thread. Only the owning thread inserts keys and bumps counters, readers
+        // merge them with relaxed loads. Shards of exited threads are kept, with their counters, for reuse.
+        struct Shard
+        {
+            Entry                 m_entries[ShardCapacity];
+            std::atomic<uint64_t> m_droppedSamples;
+            std::atomic<bool>     m_inUse;
+            Shard                *m_next;
+        };
+
+        std::atomic<Shard*> g_shards(nullptr);
+        std::atomic<size_t> g_sampleInterval(0);
+
+        Shard* AcquireShard() noexcept
+        {
+            for(Shard *shard = g_shards.load(std::memory_order_acquire); shard; shard = shard->m_next)
+            {
+                bool expected = false;
+
+                if(!shard->m_inUse.load(std::memory_order_relaxed) && shard->m_inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    return shard;
+                }
+            }
+
+            // Shards bypass Memory so that the profiler never observes (or recurses into) its own allocations.
+            void *memory = std::malloc(sizeof(Shard));
+
+            if(!memory)
+            {
+                return nullptr;
+            }
+
+            Shard *shard = new (memory) Shard();
+
+            shard->m_inUse.store(true, std::memory_order_relaxed);
+            shard->m_next = g_shards.load(std::memory_order_relaxed);
+
+            while(!g_shards.compare_exchange_weak(shard->m_next, shard, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+
+            return shard;
+        }
+
+        class ThreadState
+        {
+        private:
+            Shard    *m_shard;
+            uint64_t  m_random;
+
+        public:
+            ThreadState() noexcept
+                : m_shard(nullptr)
+                , m_random(reinterpret_cast<uintptr_t>(this) * 0x9E3779B97F4A7C15ull | 1)
+            {
+            }
+
+            ~ThreadState()
+            {
+                if(m_shard)
+                {
+                    m_shard->m_inUse.store(false, std::memory_order_release);
+                }
+            }
+
+            Shard* GetShard() noexcept
+            {
+                if(!m_shard)
+                {
+                    m_shard = AcquireShard();
+                }
+
+                return m_shard;
+            }
+
+            // Exponentially distributed distances make the samples independent of allocation patterns.
+            int64_t NextSampleDistance(size_t sampleInterval) noexcept
+            {
+                m_random ^= m_random << 13;
+                m_random ^= m_random >> 7;
+                m_random ^= m_random << 17;
+
+                const double uniform = (static_cast<double>(m_random >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+                const double distance = -std::log(uniform) * static_cast<double>(sampleInterval);
+
+                return static_cast<int64_t>(std::min(distance, static_cast<double>(sampleInterval) * 32.0)) + 1;
+            }
+        };
+
+        thread_local ThreadState t_threadState;
+
+        inline size_t HashCallSite(const char *fileName, int lineNumber) noexcept
+        {
+            uint64_t hash = (reinterpret_cast<uintptr_t>(fileName) ^ static_cast<uint64_t>(lineNumber) << 40) * 0x9E3779B97F4A7C15ull;
+
+            return static_cast<size_t>(hash >> 32);
+        }
+
+        void AddSample(Shard &shard, const char *fileName, int lineNumber, uint64_t allocationCount, uint64_t allocatedBytes) noexcept
+        {
+            size_t index = HashCallSite(fileName, lineNumber);
+
+            for(size_t probe = 0; probe < ShardCapacity; ++probe, ++index)
+            {
+                Entry &entry = shard.m_entries[index & (ShardCapacity - 1)];
+                const char *entryFileName = entry.m_fileName.load(std::memory_order_acquire);
+
+                if(!entryFileName)
+                {
+                    entry.m_lineNumber.store(lineNumber, std::memory_order_relaxed);
+                    entry.m_fileName.store(fileName, std::memory_order_release);
+                }
+                else if(entryFileName != fileName || entry.m_lineNumber.load(std::memory_order_relaxed) != lineNumber)
+                {
+                    continue;
+                }
+
+                entry.m_sampleCount.fetch_add(1, std::memory_order_relaxed);
+                entry.m_allocationCount.fetch_add(allocationCount, std::memory_order_relaxed);
+                entry.m_allocatedBytes.fetch_add(allocatedBytes, std::memory_order_relaxed);
+
+                return;
+            }
+
+            shard.m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void WriteJsonString(std::ostream &stream, const char *str)
+        {
+            stream << '"';
+
+            for(; *str; ++str)
+            {
+                const unsigned char c = static_cast<unsigned char>(*str);
+
+                if(c == '"' || c == '\\')
+                {
+                    stream << '\\' << *str;
+                }
+                else if(c < 0x20)
+                {
+                    static const char hexDigits[] = "0123456789abcdef";
+
+                    stream << "\\u00" << hexDigits[c >> 4] << hexDigits[c & 0xF];
+                }
+                else
+                {
+                    stream << *str;
+                }
+            }
+
+            stream << '"';
+        }
+    }
+
+    thread_local int64_t AllocationProfiler::t_bytesUntilSample = 0;
+
+    void AllocationProfiler::Start(size_t sampleInterval) noexcept
+    {
+        g_sampleInterval.store(sampleInterval > 0 ? sampleInterval : DefaultSampleInterval, std::memory_order_relaxed);
+
+        // Other threads notice within DefaultSampleInterval bytes, the calling thread samples its next allocation.
+        t_bytesUntilSample = 0;
+    }
+
+    void AllocationProfiler::Stop() noexcept
+    {
+        g_sampleInterval.store(0, std::memory_order_relaxed);
+    }
+
+    bool AllocationProfiler::IsRunning() noexcept
+    {
+        return g_sampleInterval.load(std::memory_order_relaxed) != 0;
+    }
+
+    void AllocationProfiler::Reset() noexcept
+    {
+        for(Shard *shard = g_shards.load(std::memory_order_acquire); shard; shard = shard->m_next)
+        {
+            for(Entry &entry : shard->m_entries)
+            {
+                entry.m_sampleCount.store(0, std::memory_order_relaxed);
+                entry.m_allocationCount.store(0, std::memory_order_relaxed);
+                entry.m_allocatedBytes.store(0, std::memory_order_relaxed);
+            }
+
+            shard->m_droppedSamples.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    AllocationProfiler::Snapshot AllocationProfiler::TakeSnapshot()
+    {
+        Snapshot snapshot;
+
+        snapshot.m_sampleInterval = g_sampleInterval.load(std::memory_order_relaxed);
+        snapshot.m_droppedSamples = 0;
+
+        for(Shard *shard = g_shards.load(std::memory_order_acquire); shard; shard = shard->m_next)
+        {
+            for(const Entry &entry : shard->m_entries)
+            {
+                const char *fileName = entry.m_fileName.load(std::memory_order_acquire);
+                const uint64_t sampleCount = entry.m_sampleCount.load(std::memory_order_relaxed);
+
+                if(fileName && sampleCount > 0)
+                {
+                    snapshot.m_callSites.push_back(CallSite
+                    {
+                        fileName,
+                        entry.m_lineNumber.load(std::memory_order_relaxed),
+                        sampleCount,
+                        entry.m_allocationCount.load(std::memory_order_relaxed),
+                        entry.m_allocatedBytes.load(std::memory_order_relaxed)
+                    });
+                }
+            }
+
+            snapshot.m_droppedSamples += shard->m_droppedSamples.load(std::memory_order_relaxed);
+        }
+
+        // The same file can be reached through different __FILE__ pointers, so merge by name.
+        std::vector<CallSite> &callSites = snapshot.m_callSites;
+
+        std::sort(callSites.begin(), callSites.end(), [](const CallSite &a, const CallSite &b)
+        {
+            const int result = std::strcmp(a.m_fileName, b.m_fileName);
+
+            return result < 0 || (result == 0 && a.m_lineNumber < b.m_lineNumber);
+        });
+
+        size_t count = 0;
+
+        for(size_t i = 0; i < callSites.size(); ++i)
+        {
+            if(count > 0 && callSites[count - 1].m_lineNumber == callSites[i].m_lineNumber && std::strcmp(callSites[count - 1].m_fileName, callSites[i].m_fileName) == 0)
+            {
+                callSites[count - 1].m_sampleCount += callSites[i].m_sampleCount;
+                callSites[count - 1].m_allocationCount += callSites[i].m_allocationCount;
+                callSites[count - 1].m_allocatedBytes += callSites[i].m_allocatedBytes;
+            }
+            else
+            {
+                callSites[count++] = callSites[i];
+            }
+        }
+
+        callSites.resize(count);
+
+        std::sort(callSites.begin(), callSites.end(), [](const CallSite &a, const CallSite &b)
+        {
+            return a.m_allocatedBytes > b.m_allocatedBytes;
+        });
+
+        return snapshot;
+    }
+
+    void AllocationProfiler::WriteText(std::ostream &stream, const Snapshot &snapshot)
+    {
+        stream << "Allocation profile (sample interval " << snapshot.m_sampleInterval << " bytes, " << snapshot.m_droppedSamples << " dropped samples)\n";
+        stream << "       bytes  allocations    samples  call site\n";
+
+        for(const CallSite &callSite : snapshot.m_callSites)
+        {
+            char line[64];
+
+            std::snprintf(line, sizeof(line), "%12llu %12llu %10llu  ", static_cast<unsigned long long>(callSite.m_allocatedBytes), static_cast<unsigned long long>(callSite.m_allocationCount), static_cast<unsigned long long>(callSite.m_sampleCount));
+
+            stream << line << callSite.m_fileName << ':' << callSite.m_lineNumber << '\n';
+        }
+    }
+
+    void AllocationProfiler::WriteJson(std::ostream &stream, const Snapshot &snapshot)
+    {
+        stream << "{\"sampleInterval\":" << snapshot.m_sampleInterval << ",\"droppedSamples\":" << snapshot.m_droppedSamples << ",\"callSites\":[";
+
+        for(size_t i = 0; i < snapshot.m_callSites.size(); ++i)
+        {
+            const CallSite &callSite = snapshot.m_callSites[i];
+
+            if(i > 0)
+            {
+                stream << ',';
+            }
+
+            stream << "{\"file\":";
+            WriteJsonString(stream, callSite.m_fileName);
+            stream << ",\"line\":" << callSite.m_lineNumber;
+            stream << ",\"samples\":" << callSite.m_sampleCount;
+            stream << ",\"allocations\":" << callSite.m_allocationCount;
+            stream << ",\"bytes\":" << callSite.m_allocatedBytes << '}';
+        }
+
+        stream << "]}";
+    }
+
+    void AllocationProfiler::RecordSample(size_t size, const char *fileName, int lineNumber) noexcept
+    {
+        const size_t sampleInterval = g_sampleInterval.load(std::memory_order_relaxed);
+
+        if(sampleInterval == 0)
+        {
+            // Check again after the default interval so that threads pick up a later Start().
+            t_bytesUntilSample = static_cast<int64_t>(DefaultSampleInterval);
+            return;
+        }
+
+        ThreadState &state = t_threadState;
+
+        t_bytesUntilSample = state.NextSampleDistance(sampleInterval);
+
+        Shard *shard = state.GetShard();
+
+        if(!shard)
+        {
+            return;
+        }
+
+        // A block of the given size is sampled with probability 1 - exp(-size / interval); weigh it by the inverse.
+        const double blockSize = static_cast<double>(size > 0 ? size : 1);
+        const double weight = 1.0 / (1.0 - std::exp(-blockSize / static_cast<double>(sampleInterval)));
+
+        AddSample(*shard, fileName ? fileName : UnknownFileName, lineNumber, static_cast<uint64_t>(weight + 0.5), static_cast<uint64_t>(blockSize * weight + 0.5));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef _DOTNETNATIVE_ALLOCATIONPROFILER_H_
+#define _DOTNETNATIVE_ALLOCATIONPROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace DotNetNative
+{
+    // A sampling heap profiler keyed by call site. Compile with DNN_ALLOCATION_PROFILING to make the DNN_Alloc family,
+    // DNN_New and DNN_Allocator capture __FILE__/__LINE__ in release builds and feed the profiler, then call Start().
+    //
+    // Every thread counts down the bytes it allocates and records a sample roughly every SampleInterval bytes, so the
+    // cost of an allocation that is not sampled is one thread-local subtraction. Samples are aggregated into
+    // per-thread shards of relaxed atomic counters and scaled back to estimated allocation counts and bytes.
+    class AllocationProfiler
+    {
+    public:
+        static constexpr size_t DefaultSampleInterval = 512 * 1024;
+
+        struct CallSite
+        {
+            const char *m_fileName;
+            int         m_lineNumber;
+            uint64_t    m_sampleCount;
+            uint64_t    m_allocationCount;
+            uint64_t    m_allocatedBytes;
+        };
+
+        struct Snapshot
+        {
+            size_t                m_sampleInterval;
+            uint64_t              m_droppedSamples;
+            std::vector<CallSite> m_callSites;
+        };
+
+    private:
+        static thread_local int64_t t_bytesUntilSample;
+
+    private:
+        AllocationProfiler() = delete;
+        AllocationProfiler(const AllocationProfiler &copy) = delete;
+        AllocationProfiler(AllocationProfiler &&mov) = delete;
+        ~AllocationProfiler() = delete;
+
+    public:
+        static void Start(size_t sampleInterval = DefaultSampleInterval) noexcept;
+        static void Stop() noexcept;
+        static bool IsRunning() noexcept;
+
+        // Clears the counters of every thread. Samples recorded concurrently may survive the reset.
+        static void Reset() noexcept;
+
+        // Merges the shards of all threads. Call sites are ordered by estimated bytes, largest first.
+        static Snapshot TakeSnapshot();
+
+        static void WriteText(std::ostream &stream, const Snapshot &snapshot);
+        static void WriteJson(std::ostream &stream, const Snapshot &snapshot);
+
+        inline static void OnAllocation(size_t size, const char *fileName, int lineNumber) noexcept
+        {
+            t_bytesUntilSample -= static_cast<int64_t>(size);
+
+            if(t_bytesUntilSample < 0)
+            {
+                RecordSample(size, fileName, lineNumber);
+            }
+        }
+
+    private:
+        static void RecordSample(size_t size, const char *fileName, int lineNumber) noexcept;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef _DOTNETNATIVE_ALLOCATORHOOKS_H_
+#define _DOTNETNATIVE_ALLOCATORHOOKS_H_
+
+#include <cstddef>
+
+namespace DotNetNative
+{
+    // The table of plain function pointers Memory dispatches to. Every hook receives the m_context pointer of
+    // the table, which lets a single set of functions serve several allocator instances. The sized free hooks
+    // receive the size that was requested when the block was allocated (or last reallocated).
+    struct AllocatorHooks
+    {
+        typedef void* (*AllocHook)(void *context, size_t size);
+        typedef void* (*CAllocHook)(void *context, size_t count, size_t size);
+        typedef void* (*ReallocHook)(void *context, void *memory, size_t size);
+        typedef void (*FreeHook)(void *context, void *memory);
+        typedef void (*SizedFreeHook)(void *context, void *memory, size_t size);
+
+        typedef void* (*AlignedAllocHook)(void *context, size_t size, size_t alignment);
+        typedef void* (*AlignedCAllocHook)(void *context, size_t count, size_t size, size_t alignment);
+        typedef void* (*AlignedReallocHook)(void *context, void *memory, size_t size, size_t alignment);
+        typedef void (*AlignedFreeHook)(void *context, void *memory);
+        typedef void (*AlignedSizedFreeHook)(void *context, void *memory, size_t size, size_t alignment);
+
+        typedef void* (*AllocDebugHook)(void *context, size_t size, const char *fileName, int lineNumber);
+        typedef void* (*CAllocDebugHook)(void *context, size_t count, size_t size, const char *fileName, int lineNumber);
+        typedef void* (*ReallocDebugHook)(void *context, void *memory, size_t size, const char *fileName, int lineNumber);
+        typedef void (*FreeDebugHook)(void *context, void *memory, const char *fileName, int lineNumber);
+        typedef void (*SizedFreeDebugHook)(void *context, void *memory, size_t size, const char *fileName, int lineNumber);
+
+        typedef void* (*AlignedAllocDebugHook)(void *context, size_t size, size_t alignment, const char *fileName, int lineNumber);
+        typedef void* (*AlignedCAllocDebugHook)(void *context, size_t count, size_t size, size_t alignment, const char *fileName, int lineNumber);
+        typedef void* (*AlignedReallocDebugHook)(void *context, void *memory, size_t size, size_t alignment, const char *fileName, int lineNumber);
+        typedef void (*AlignedFreeDebugHook)(void *context, void *memory, const char *fileName, int lineNumber);
+        typedef void (*AlignedSizedFreeDebugHook)(void *context, void *memory, size_t size, size_t alignment, const char *fileName, int lineNumber);
+
+        void                     *m_context;
+
+        AllocHook                 m_alloc;
+        CAllocHook                m_calloc;
+        ReallocHook               m_realloc;
+        FreeHook                  m_free;
+        SizedFreeHook             m_sizedFree;
+
+        AlignedAllocHook          m_alignedAlloc;
+        AlignedCAllocHook         m_alignedCAlloc;
+        AlignedReallocHook        m_alignedRealloc;
+        AlignedFreeHook           m_alignedFree;
+        AlignedSizedFreeHook      m_alignedSizedFree;
+
+        AllocDebugHook            m_debugAlloc;
+        CAllocDebugHook           m_debugCAlloc;
+        ReallocDebugHook          m_debugRealloc;
+        FreeDebugHook             m_debugFree;
+        SizedFreeDebugHook        m_debugSizedFree;
+
+        AlignedAllocDebugHook     m_debugAlignedAlloc;
+        AlignedCAllocDebugHook    m_debugAlignedCAlloc;
+        AlignedReallocDebugHook   m_debugAlignedRealloc;
+        AlignedFreeDebugHook      m_debugAlignedFree;
+        AlignedSizedFreeDebugHook m_debugAlignedSizedFree;
+    };
+
+    // Builds a hook table from an allocator policy: a class with the static functions Alloc, CAlloc, Realloc, Free,
+    // AlignedAlloc, AlignedCAlloc, AlignedRealloc and AlignedFree, plus the sized overloads Free(memory, size) and
+    // AlignedFree(memory, size, alignment). The debug hooks drop the call site.
+    template <typename TPolicy>
+    constexpr AllocatorHooks MakeAllocatorHooks() noexcept
+    {
+        return AllocatorHooks
+        {
+            nullptr,
+
+            [](void*, size_t size) { return TPolicy::Alloc(size); },
+            [](void*, size_t count, size_t size) { return TPolicy::CAlloc(count, size); },
+            [](void*, void *memory, size_t size) { return TPolicy::Realloc(memory, size); },
+            [](void*, void *memory) { TPolicy::Free(memory); },
+            [](void*, void *memory, size_t size) { TPolicy::Free(memory, size); },
+
+            [](void*, size_t size, size_t alignment) { return TPolicy::AlignedAlloc(size, alignment); },
+            [](void*, size_t count, size_t size, size_t alignment) { return TPolicy::AlignedCAlloc(count, size, alignment); },
+            [](void*, void *memory, size_t size, size_t alignment) { return TPolicy::AlignedRealloc(memory, size, alignment); },
+            [](void*, void *memory) { TPolicy::AlignedFree(memory); },
+            [](void*, void *memory, size_t size, size_t alignment) { TPolicy::AlignedFree(memory, size, alignment); },
+
+            [](void*, size_t size, const char*, int) { return TPolicy::Alloc(size); },
+            [](void*, size_t count, size_t size, const char*, int) { return TPolicy::CAlloc(count, size); },
+            [](void*, void *memory, size_t size, const char*, int) { return TPolicy::Realloc(memory, size); },
+            [](void*, void *memory, const char*, int) { TPolicy::Free(memory); },
+            [](void*, void *memory, size_t size, const char*, int) { TPolicy::Free(memory, size); },
+
+            [](void*, size_t size, size_t alignment, const char*, int) { return TPolicy::AlignedAlloc(size, alignment); },
+            [](void*, size_t count, size_t size, size_t alignment, const char*, int) { return TPolicy::AlignedCAlloc(count, size, alignment); },
+            [](void*, void *memory, size_t size, size_t alignment, const char*, int) { return TPolicy::AlignedRealloc(memory, size, alignment); },
+            [](void*, void *memory, const char*, int) { TPolicy::AlignedFree(memory); },
+            [](void*, void *memory, size_t size, size_t alignment, const char*, int) { TPolicy::AlignedFree(memory, size, alignment); }
+        };
+    }
+}
+
+#endif
\ No newline at end of file
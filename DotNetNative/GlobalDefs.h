@@ -4,6 +4,15 @@
 #include <cstdint>
 #include <type_traits>
 
+// SIMD code paths. SSE2 is part of every x64 target, AVX2 is used when the compiler targets it (/arch:AVX2, -mavx2).
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define DNN_SSE2
+#endif
+
+#ifdef __AVX2__
+#define DNN_AVX2
+#endif
+
 namespace DotNetNative
 {
     typedef char asciichar;
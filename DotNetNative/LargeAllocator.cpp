@@ -0,0 +1,287 @@
+#include "LargeAllocator.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace DotNetNative
+{
+    namespace
+    {
+        std::atomic<bool>   g_useExplicitHugePages(false);
+        std::atomic<size_t> g_blockCount(0);
+        std::atomic<size_t> g_mappedBytes(0);
+        std::atomic<size_t> g_hugePageBlockCount(0);
+        std::atomic<size_t> g_remapCount(0);
+
+        inline size_t RoundUp(size_t size, size_t granularity) noexcept
+        {
+            return (size + granularity - 1) & ~(granularity - 1);
+        }
+
+        // Returns the size of the mapping for a block, or 0 if it would overflow.
+        inline size_t GetMappedSize(size_t size) noexcept
+        {
+            if(size > SIZE_MAX - LargeAllocator::HeaderSize - LargeAllocator::HugePageSize)
+            {
+                return 0;
+            }
+
+            const size_t mappedSize = RoundUp(size + LargeAllocator::HeaderSize, LargeAllocator::PageSize);
+
+            // Huge pages only back whole 2MB ranges, so round up once the block reaches the first one.
+            return mappedSize >= LargeAllocator::HugePageSize ? RoundUp(mappedSize, LargeAllocator::HugePageSize) : mappedSize;
+        }
+
+        void* MapExplicitHugePages(size_t mappedSize) noexcept
+        {
+#ifdef _WIN32
+            const size_t largePageSize = ::GetLargePageMinimum();
+
+            if(largePageSize == 0 || mappedSize % largePageSize != 0)
+            {
+                return nullptr;
+            }
+
+            return ::VirtualAlloc(nullptr, mappedSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+#elif defined(MAP_HUGETLB)
+            void *mapping = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+            return mapping != MAP_FAILED ? mapping : nullptr;
+#else
+            (void)mappedSize;
+
+            return nullptr;
+#endif
+        }
+
+        void* MapPages(size_t mappedSize) noexcept
+        {
+#ifdef _WIN32
+            // Allocations are aligned to the 64KB allocation granularity; Windows has no transparent huge pages.
+            return ::VirtualAlloc(nullptr, mappedSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+            if(mappedSize < LargeAllocator::HugePageSize)
+            {
+                void *mapping = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+                return mapping != MAP_FAILED ? mapping : nullptr;
+            }
+
+            // Over-map and trim the mapping to a huge page boundary so that the kernel can back it with huge pages.
+            const size_t overSize = mappedSize + LargeAllocator::HugePageSize;
+            void *mapping = ::mmap(nullptr, overSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if(mapping == MAP_FAILED)
+            {
+                return nullptr;
+            }
+
+            const uintptr_t base = reinterpret_cast<uintptr_t>(mapping);
+            const uintptr_t aligned = RoundUp(base, LargeAllocator::HugePageSize);
+            const size_t head = aligned - base;
+            const size_t tail = overSize - head - mappedSize;
+
+            if(head > 0)
+            {
+                ::munmap(mapping, head);
+            }
+
+            if(tail > 0)
+            {
+                ::munmap(reinterpret_cast<void*>(aligned + mappedSize), tail);
+            }
+
+#ifdef MADV_HUGEPAGE
+            ::madvise(reinterpret_cast<void*>(aligned), mappedSize, MADV_HUGEPAGE);
+#endif
+
+            return reinterpret_cast<void*>(aligned);
+#endif
+        }
+
+        void UnmapPages(void *mapping, size_t mappedSize) noexcept
+        {
+#ifdef _WIN32
+            (void)mappedSize;
+
+            ::VirtualFree(mapping, 0, MEM_RELEASE);
+#else
+            ::munmap(mapping, mappedSize);
+#endif
+        }
+    }
+
+    std::atomic<size_t> LargeAllocator::g_threshold(LargeAllocator::DefaultThreshold);
+
+    void LargeAllocator::SetThreshold(size_t threshold) noexcept
+    {
+        // Smaller blocks would waste most of their pages.
+        g_threshold.store(threshold < PageSize ? PageSize : threshold, std::memory_order_relaxed);
+    }
+
+    void LargeAllocator::SetUseExplicitHugePages(bool useExplicitHugePages) noexcept
+    {
+        g_useExplicitHugePages.store(useExplicitHugePages, std::memory_order_relaxed);
+    }
+
+    void* LargeAllocator::Alloc(size_t size) noexcept
+    {
+        const size_t mappedSize = GetMappedSize(size);
+
+        if(mappedSize == 0)
+        {
+            return nullptr;
+        }
+
+        void *mapping = nullptr;
+        bool explicitHugePages = false;
+
+        if(mappedSize >= HugePageSize && g_useExplicitHugePages.load(std::memory_order_relaxed))
+        {
+            mapping = MapExplicitHugePages(mappedSize);
+            explicitHugePages = mapping != nullptr;
+        }
+
+        if(!mapping)
+        {
+            mapping = MapPages(mappedSize);
+
+            if(!mapping)
+            {
+                return nullptr;
+            }
+        }
+
+        BlockHeader *header = static_cast<BlockHeader*>(mapping);
+
+        header->m_magic = BlockMagic;
+        header->m_self = header;
+        header->m_size = size;
+        header->m_mappedSize = mappedSize;
+        header->m_explicitHugePages = explicitHugePages;
+
+        g_blockCount.fetch_add(1, std::memory_order_relaxed);
+        g_mappedBytes.fetch_add(mappedSize, std::memory_order_relaxed);
+
+        if(explicitHugePages)
+        {
+            g_hugePageBlockCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return static_cast<uint8_t*>(mapping) + HeaderSize;
+    }
+
+    void* LargeAllocator::Realloc(void *memory, size_t size) noexcept
+    {
+        if(!memory)
+        {
+            return Alloc(size);
+        }
+
+        BlockHeader *header = reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(memory) - HeaderSize);
+        const size_t mappedSize = GetMappedSize(size);
+
+        if(mappedSize == 0)
+        {
+            return nullptr;
+        }
+
+        if(mappedSize == header->m_mappedSize)
+        {
+            header->m_size = size;
+            return memory;
+        }
+
+#if !defined(_WIN32) && defined(MREMAP_MAYMOVE)
+        // Explicit huge page mappings can only be resized in whole huge pages, which GetMappedSize guarantees.
+        if(!header->m_explicitHugePages || mappedSize >= HugePageSize)
+        {
+            const size_t oldMappedSize = header->m_mappedSize;
+            void *mapping = ::mremap(header, oldMappedSize, mappedSize, MREMAP_MAYMOVE);
+
+            if(mapping != MAP_FAILED)
+            {
+                header = static_cast<BlockHeader*>(mapping);
+                header->m_self = header;
+                header->m_size = size;
+                header->m_mappedSize = mappedSize;
+
+#ifdef MADV_HUGEPAGE
+                if(mappedSize >= HugePageSize && !header->m_explicitHugePages)
+                {
+                    ::madvise(mapping, mappedSize, MADV_HUGEPAGE);
+                }
+#endif
+
+                g_mappedBytes.fetch_add(mappedSize - oldMappedSize, std::memory_order_relaxed);
+                g_remapCount.fetch_add(1, std::memory_order_relaxed);
+
+                return static_cast<uint8_t*>(mapping) + HeaderSize;
+            }
+        }
+#endif
+
+        // Without mremap a shrinking block keeps its pages.
+        if(mappedSize < header->m_mappedSize)
+        {
+            header->m_size = size;
+            return memory;
+        }
+
+        void *newMemory = Alloc(size);
+
+        if(newMemory)
+        {
+            std::memcpy(newMemory, memory, header->m_size < size ? header->m_size : size);
+
+            Free(memory);
+        }
+
+        return newMemory;
+    }
+
+    void LargeAllocator::Free(void *memory) noexcept
+    {
+        if(!memory)
+        {
+            return;
+        }
+
+        BlockHeader *header = reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(memory) - HeaderSize);
+        const size_t mappedSize = header->m_mappedSize;
+
+        if(header->m_explicitHugePages)
+        {
+            g_hugePageBlockCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        g_blockCount.fetch_sub(1, std::memory_order_relaxed);
+        g_mappedBytes.fetch_sub(mappedSize, std::memory_order_relaxed);
+
+        UnmapPages(header, mappedSize);
+    }
+
+    size_t LargeAllocator::GetSize(const void *memory) noexcept
+    {
+        return reinterpret_cast<const BlockHeader*>(static_cast<const uint8_t*>(memory) - HeaderSize)->m_size;
+    }
+
+    LargeAllocator::Statistics LargeAllocator::GetStatistics() noexcept
+    {
+        Statistics stats;
+
+        stats.m_blockCount = g_blockCount.load(std::memory_order_relaxed);
+        stats.m_mappedBytes = g_mappedBytes.load(std::memory_order_relaxed);
+        stats.m_hugePageBlockCount = g_hugePageBlockCount.load(std::memory_order_relaxed);
+        stats.m_remapCount = g_remapCount.load(std::memory_order_relaxed);
+
+        return stats;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef _DOTNETNATIVE_LARGEALLOCATOR_H_
+#define _DOTNETNATIVE_LARGEALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace DotNetNative
+{
+    // Serves blocks of at least GetThreshold() bytes straight from the operating system (mmap or VirtualAlloc), so
+    // that large tables end up on fresh, zeroed pages and, where supported, on huge pages. Mappings of 2MB and more
+    // are aligned to 2MB and marked for transparent huge pages; explicit huge pages can be enabled as well.
+    // On Linux Realloc grows and shrinks blocks with mremap, which moves the page mappings instead of copying.
+    //
+    // The default backends of Memory, including SizeClassAllocator, route large requests here and recognize the
+    // blocks on release. A block starts HeaderSize bytes into its first page, which is checked before its header.
+    class LargeAllocator
+    {
+    public:
+        static constexpr size_t HeaderSize = 64;
+        static constexpr size_t PageSize = 4096;
+        static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+        static constexpr size_t DefaultThreshold = 1024 * 1024;
+
+        struct Statistics
+        {
+            size_t m_blockCount;
+            size_t m_mappedBytes;
+            size_t m_hugePageBlockCount;
+            size_t m_remapCount;
+        };
+
+    private:
+        struct BlockHeader
+        {
+            uint64_t     m_magic;
+            BlockHeader *m_self;
+            size_t       m_size;
+            size_t       m_mappedSize;
+            bool         m_explicitHugePages;
+        };
+
+        static_assert(sizeof(BlockHeader) <= HeaderSize, "BlockHeader must fit in front of the block.");
+
+        static constexpr uint64_t BlockMagic = 0x4c41524745424c4b; // 'LARGEBLK'
+
+        static std::atomic<size_t> g_threshold;
+
+    private:
+        LargeAllocator() = delete;
+        LargeAllocator(const LargeAllocator &copy) = delete;
+        LargeAllocator(LargeAllocator &&mov) = delete;
+        ~LargeAllocator() = delete;
+
+    public:
+        // Requests below the threshold are left to the regular heap. SIZE_MAX disables the large tier.
+        static void SetThreshold(size_t threshold) noexcept;
+
+        inline static size_t GetThreshold() noexcept
+        {
+            return g_threshold.load(std::memory_order_relaxed);
+        }
+
+        inline static bool IsLarge(size_t size) noexcept
+        {
+            return size >= GetThreshold();
+        }
+
+        // Backs mappings that are a multiple of HugePageSize with explicit huge pages (MAP_HUGETLB or MEM_LARGE_PAGES)
+        // when the system has them reserved, falling back to regular pages otherwise. Disabled by default.
+        static void SetUseExplicitHugePages(bool useExplicitHugePages) noexcept;
+
+        inline static bool Owns(const void *memory) noexcept
+        {
+            const uintptr_t address = reinterpret_cast<uintptr_t>(memory);
+
+            // The header shares the page of the block, so it can be read whatever allocated the block.
+            if((address & (PageSize - 1)) != HeaderSize)
+            {
+                return false;
+            }
+
+            const BlockHeader *header = reinterpret_cast<const BlockHeader*>(address - HeaderSize);
+
+            return header->m_magic == BlockMagic && header->m_self == header;
+        }
+
+        // Returns zeroed memory, or nullptr if the mapping failed.
+        static void* Alloc(size_t size) noexcept;
+
+        // The block must be owned by the large allocator. Returns nullptr, leaving the block untouched, on failure.
+        static void* Realloc(void *memory, size_t size) noexcept;
+
+        static void Free(void *memory) noexcept;
+
+        // Returns the size the block was allocated or last reallocated with.
+        static size_t GetSize(const void *memory) noexcept;
+
+        static Statistics GetStatistics() noexcept;
+    };
+}
+
+#endif
\ No newline at end of file
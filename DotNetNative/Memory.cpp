@@ -1,173 +1,659 @@
 #include "Memory.h"
+#include "MemoryArena.h"
+#include "LargeAllocator.h"
 
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
+
+#ifndef _WIN32
+#include <malloc.h>
+#endif
+
+#ifdef DNN_USE_SIZE_CLASS_ALLOCATOR
+#include "SizeClassAllocator.h"
+#endif
 
 namespace DotNetNative
 {
+    namespace
+    {
+        // The backend used when no allocator hooks have been installed.
+#ifdef DNN_USE_SIZE_CLASS_ALLOCATOR
+        void* DefaultAlloc(void*, size_t size) { return SizeClassAllocator::Alloc(size); }
+        void* DefaultCAlloc(void*, size_t count, size_t size) { return SizeClassAllocator::CAlloc(count, size); }
+        void* DefaultRealloc(void*, void *memory, size_t size) { return SizeClassAllocator::Realloc(memory, size); }
+        void DefaultFree(void*, void *memory) { SizeClassAllocator::Free(memory); }
+        void DefaultSizedFree(void*, void *memory, size_t size) { SizeClassAllocator::Free(memory, size); }
+
+        void* DefaultAlignedAlloc(void*, size_t size, size_t alignment) { return SizeClassAllocator::AlignedAlloc(size, alignment); }
+        void* DefaultAlignedCAlloc(void*, size_t count, size_t size, size_t alignment) { return SizeClassAllocator::AlignedCAlloc(count, size, alignment); }
+        void* DefaultAlignedRealloc(void*, void *memory, size_t size, size_t alignment) { return SizeClassAllocator::AlignedRealloc(memory, size, alignment); }
+        void DefaultAlignedFree(void*, void *memory) { SizeClassAllocator::AlignedFree(memory); }
+        void DefaultAlignedSizedFree(void*, void *memory, size_t size, size_t alignment) { SizeClassAllocator::AlignedFree(memory, size, alignment); }
+
+        void* DefaultDebugAlloc(void*, size_t size, const char*, int) { return SizeClassAllocator::Alloc(size); }
+        void* DefaultDebugCAlloc(void*, size_t count, size_t size, const char*, int) { return SizeClassAllocator::CAlloc(count, size); }
+        void* DefaultDebugRealloc(void*, void *memory, size_t size, const char*, int) { return SizeClassAllocator::Realloc(memory, size); }
+        void DefaultDebugFree(void*, void *memory, const char*, int) { SizeClassAllocator::Free(memory); }
+        void DefaultDebugSizedFree(void*, void *memory, size_t size, const char*, int) { SizeClassAllocator::Free(memory, size); }
+
+        void* DefaultDebugAlignedAlloc(void*, size_t size, size_t alignment, const char*, int) { return SizeClassAllocator::AlignedAlloc(size, alignment); }
+        void* DefaultDebugAlignedCAlloc(void*, size_t count, size_t size, size_t alignment, const char*, int) { return SizeClassAllocator::AlignedCAlloc(count, size, alignment); }
+        void* DefaultDebugAlignedRealloc(void*, void *memory, size_t size, size_t alignment, const char*, int) { return SizeClassAllocator::AlignedRealloc(memory, size, alignment); }
+        void DefaultDebugAlignedFree(void*, void *memory, const char*, int) { SizeClassAllocator::AlignedFree(memory); }
+        void DefaultDebugAlignedSizedFree(void*, void *memory, size_t size, size_t alignment, const char*, int) { SizeClassAllocator::AlignedFree(memory, size, alignment); }
+#else
+#ifdef _WIN32
+        inline size_t HeapBlockSize(void *memory) { return ::_msize(memory); }
+
+        inline void* PlatformAlignedAlloc(size_t size, size_t alignment) { return ::_aligned_malloc(size, alignment); }
+        inline void* PlatformAlignedCAlloc(size_t count, size_t size, size_t alignment) { return ::_aligned_recalloc(nullptr, count, size, alignment); }
+        inline void* PlatformAlignedRealloc(void *memory, size_t size, size_t alignment) { return ::_aligned_realloc(memory, size, alignment); }
+        inline void PlatformAlignedFree(void *memory) { ::_aligned_free(memory); }
+#else
+        inline size_t HeapBlockSize(void *memory) { return ::malloc_usable_size(memory); }
+
+        // posix_memalign wants a power of two of at least sizeof(void*); smaller alignments get what malloc guarantees.
+        void* PlatformAlignedAlloc(size_t size, size_t alignment)
+        {
+            void *memory = nullptr;
+
+            return ::posix_memalign(&memory, alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment, size) == 0 ? memory : nullptr;
+        }
+
+        void* PlatformAlignedCAlloc(size_t count, size_t size, size_t alignment)
+        {
+            if(count != 0 && size > SIZE_MAX / count)
+            {
+                return nullptr;
+            }
+
+            void *memory = PlatformAlignedAlloc(count * size, alignment);
+
+            if(memory)
+            {
+                std::memset(memory, 0, count * size);
+            }
+
+            return memory;
+        }
+
+        // realloc may move a block to an address with only malloc's alignment, so blocks are kept when they shrink
+        // moderately and moved to a new aligned block otherwise. Like _aligned_realloc, a size of 0 frees the block.
+        void* PlatformAlignedRealloc(void *memory, size_t size, size_t alignment)
+        {
+            if(!memory)
+            {
+                return PlatformAlignedAlloc(size, alignment);
+            }
+
+            if(size == 0)
+            {
+                std::free(memory);
+                return nullptr;
+            }
+
+            const size_t oldSize = HeapBlockSize(memory);
+
+            if(size <= oldSize && size >= oldSize / 2)
+            {
+                return memory;
+            }
+
+            void *newMemory = PlatformAlignedAlloc(size, alignment);
+
+            if(newMemory)
+            {
+                std::memcpy(newMemory, memory, oldSize < size ? oldSize : size);
+                std::free(memory);
+            }
+
+            return newMemory;
+        }
+
+        inline void PlatformAlignedFree(void *memory) { std::free(memory); }
+#endif
+
+        // Moves a heap block that grows past the large allocation threshold into the large allocator.
+        void* ReallocToLarge(void *memory, size_t size)
+        {
+            void *newMemory = LargeAllocator::Alloc(size);
+
+            if(newMemory && memory)
+            {
+                const size_t oldSize = HeapBlockSize(memory);
+
+                std::memcpy(newMemory, memory, oldSize < size ? oldSize : size);
+                std::free(memory);
+            }
+
+            return newMemory;
+        }
+
+        inline bool IsLargeCount(size_t count, size_t size) { return (count == 0 || size <= SIZE_MAX / count) && LargeAllocator::IsLarge(count * size); }
+        inline bool IsLargeAligned(size_t size, size_t alignment) { return alignment <= LargeAllocator::HeaderSize && LargeAllocator::IsLarge(size); }
+
+        void* DefaultAlloc(void*, size_t size) { return LargeAllocator::IsLarge(size) ? LargeAllocator::Alloc(size) : std::malloc(size); }
+        void* DefaultCAlloc(void*, size_t count, size_t size) { return IsLargeCount(count, size) ? LargeAllocator::Alloc(count * size) : std::calloc(count, size); }
+        void DefaultFree(void*, void *memory) { LargeAllocator::Owns(memory) ? LargeAllocator::Free(memory) : std::free(memory); }
+        void DefaultSizedFree(void*, void *memory, size_t) { LargeAllocator::Owns(memory) ? LargeAllocator::Free(memory) : std::free(memory); }
+
+        void* DefaultRealloc(void*, void *memory, size_t size)
+        {
+            if(LargeAllocator::Owns(memory))
+            {
+                return LargeAllocator::Realloc(memory, size);
+            }
+
+            return LargeAllocator::IsLarge(size) ? ReallocToLarge(memory, size) : std::realloc(memory, size);
+        }
+
+        void* DefaultAlignedAlloc(void*, size_t size, size_t alignment) { return IsLargeAligned(size, alignment) ? LargeAllocator::Alloc(size) : PlatformAlignedAlloc(size, alignment); }
+        void* DefaultAlignedCAlloc(void*, size_t count, size_t size, size_t alignment) { return IsLargeCount(count, size) && alignment <= LargeAllocator::HeaderSize ? LargeAllocator::Alloc(count * size) : PlatformAlignedCAlloc(count, size, alignment); }
+        void* DefaultAlignedRealloc(void*, void *memory, size_t size, size_t alignment) { return LargeAllocator::Owns(memory) ? LargeAllocator::Realloc(memory, size) : PlatformAlignedRealloc(memory, size, alignment); }
+        void DefaultAlignedFree(void*, void *memory) { LargeAllocator::Owns(memory) ? LargeAllocator::Free(memory) : PlatformAlignedFree(memory); }
+        void DefaultAlignedSizedFree(void*, void *memory, size_t, size_t) { LargeAllocator::Owns(memory) ? LargeAllocator::Free(memory) : PlatformAlignedFree(memory); }
+
+#ifdef _WIN32
+        void* DefaultDebugAlloc(void*, size_t size, const char *fileName, int lineNumber) { return LargeAllocator::IsLarge(size) ? LargeAllocator::Alloc(size) : ::_malloc_dbg(size, _NORMAL_BLOCK, fileName, lineNumber); }
+        void* DefaultDebugCAlloc(void*, size_t count, size_t size, const char *fileName, int lineNumber) { return IsLargeCount(count, size) ? LargeAllocator::Alloc(count * size) : ::_calloc_dbg(count, size, _NORMAL_BLOCK, fileName, lineNumber); }
+        void* DefaultDebugRealloc(void*, void *memory, size_t size, const char *fileName, int lineNumber) { return LargeAllocator::Owns(memory) ? LargeAllocator::Realloc(memory, size) : ::_realloc_dbg(memory, size, _NORMAL_BLOCK, fileName, lineNumber); }
+        void DefaultDebugFree(void*, void *memory, const char*, int) { LargeAllocator::Owns(memory) ? LargeAllocator::Free(memory) : ::_free_dbg(memory, _NORMAL_BLOCK); }
+        void DefaultDebugSizedFree(void*, void *memory, size_t, const char*, int) { LargeAllocator::Owns(memory) ? LargeAllocator::Free(memory) : ::_free_dbg(memory, _NORMAL_BLOCK); }
+
+        void* DefaultDebugAlignedAlloc(void*, size_t size, size_t alignment, const char *fileName, int lineNumber) { return IsLargeAligned(size, alignment) ? LargeAllocator::Alloc(size) : ::_aligned_malloc_dbg(size, alignment, fileName, lineNumber); }
+        void* DefaultDebugAlignedCAlloc(void*, size_t count, size_t size, size_t alignment, const char *fileName, int lineNumber) { return IsLargeCount(count, size) && alignment <= LargeAllocator::HeaderSize ? LargeAllocator::Alloc(count * size) : ::_aligned_recalloc_dbg(nullptr, count, size, alignment, fileName, lineNumber); }
+        void* DefaultDebugAlignedRealloc(void*, void *memory, size_t size, size_t alignment, const char *fileName, int lineNumber) { return LargeAllocator::Owns(memory) ? LargeAllocator::Realloc(memory, size) : ::_aligned_realloc_dbg(memory, size, alignment, fileName, lineNumber); }
+        void DefaultDebugAlignedFree(void*, void *memory, const char*, int) { LargeAllocator::Owns(memory) ? LargeAllocator::Free(memory) : ::_aligned_free_dbg(memory); }
+        void DefaultDebugAlignedSizedFree(void*, void *memory, size_t, size_t, const char*, int) { LargeAllocator::Owns(memory) ? LargeAllocator::Free(memory) : ::_aligned_free_dbg(memory); }
+#else
+        // The debug heap of the C runtime only exists on Windows.
+        void* DefaultDebugAlloc(void *context, size_t size, const char*, int) { return DefaultAlloc(context, size); }
+        void* DefaultDebugCAlloc(void *context, size_t count, size_t size, const char*, int) { return DefaultCAlloc(context, count, size); }
+        void* DefaultDebugRealloc(void *context, void *memory, size_t size, const char*, int) { return DefaultRealloc(context, memory, size); }
+        void DefaultDebugFree(void *context, void *memory, const char*, int) { DefaultFree(context, memory); }
+        void DefaultDebugSizedFree(void *context, void *memory, size_t size, const char*, int) { DefaultSizedFree(context, memory, size); }
+
+        void* DefaultDebugAlignedAlloc(void *context, size_t size, size_t alignment, const char*, int) { return DefaultAlignedAlloc(context, size, alignment); }
+        void* DefaultDebugAlignedCAlloc(void *context, size_t count, size_t size, size_t alignment, const char*, int) { return DefaultAlignedCAlloc(context, count, size, alignment); }
+        void* DefaultDebugAlignedRealloc(void *context, void *memory, size_t size, size_t alignment, const char*, int) { return DefaultAlignedRealloc(context, memory, size, alignment); }
+        void DefaultDebugAlignedFree(void *context, void *memory, const char*, int) { DefaultAlignedFree(context, memory); }
+        void DefaultDebugAlignedSizedFree(void *context, void *memory, size_t size, size_t alignment, const char*, int) { DefaultAlignedSizedFree(context, memory, size, alignment); }
+#endif
+#endif
+
+        // Constant-initialized so that allocations made during static initialization find a valid table.
+        constexpr AllocatorHooks g_defaultHooks =
+        {
+            nullptr,
+
+            &DefaultAlloc,
+            &DefaultCAlloc,
+            &DefaultRealloc,
+            &DefaultFree,
+            &DefaultSizedFree,
+
+            &DefaultAlignedAlloc,
+            &DefaultAlignedCAlloc,
+            &DefaultAlignedRealloc,
+            &DefaultAlignedFree,
+            &DefaultAlignedSizedFree,
+
+            &DefaultDebugAlloc,
+            &DefaultDebugCAlloc,
+            &DefaultDebugRealloc,
+            &DefaultDebugFree,
+            &DefaultDebugSizedFree,
+
+            &DefaultDebugAlignedAlloc,
+            &DefaultDebugAlignedCAlloc,
+            &DefaultDebugAlignedRealloc,
+            &DefaultDebugAlignedFree,
+            &DefaultDebugAlignedSizedFree
+        };
+
+        // Trampolines from the hook table to the std::function descriptors installed by SetAllocators.
+        inline Memory::AllocatorDescriptors& Descriptors(void *context) { return *static_cast<Memory::AllocatorDescriptors*>(context); }
+
+        void* DescriptorAlloc(void *context, size_t size) { return Descriptors(context).m_alloc(size); }
+        void* DescriptorCAlloc(void *context, size_t count, size_t size) { return Descriptors(context).m_calloc(count, size); }
+        void* DescriptorRealloc(void *context, void *memory, size_t size) { return Descriptors(context).m_realloc(memory, size); }
+        void DescriptorFree(void *context, void *memory) { Descriptors(context).m_free(memory); }
+        void DescriptorSizedFree(void *context, void *memory, size_t) { Descriptors(context).m_free(memory); }
+
+        void* DescriptorAlignedAlloc(void *context, size_t size, size_t alignment) { return Descriptors(context).m_alignedAlloc(size, alignment); }
+        void* DescriptorAlignedCAlloc(void *context, size_t count, size_t size, size_t alignment) { return Descriptors(context).m_alignedCAlloc(count, size, alignment); }
+        void* DescriptorAlignedRealloc(void *context, void *memory, size_t size, size_t alignment) { return Descriptors(context).m_alignedRealloc(memory, size, alignment); }
+        void DescriptorAlignedFree(void *context, void *memory) { Descriptors(context).m_alignedFree(memory); }
+        void DescriptorAlignedSizedFree(void *context, void *memory, size_t, size_t) { Descriptors(context).m_alignedFree(memory); }
+
+        void* DescriptorDebugAlloc(void *context, size_t size, const char *fileName, int lineNumber) { return Descriptors(context).m_debugAlloc(size, fileName, lineNumber); }
+        void* DescriptorDebugCAlloc(void *context, size_t count, size_t size, const char *fileName, int lineNumber) { return Descriptors(context).m_debugCAlloc(count, size, fileName, lineNumber); }
+        void* DescriptorDebugRealloc(void *context, void *memory, size_t size, const char *fileName, int lineNumber) { return Descriptors(context).m_debugRealloc(memory, size, fileName, lineNumber); }
+        void DescriptorDebugFree(void *context, void *memory, const char *fileName, int lineNumber) { Descriptors(context).m_debugFree(memory, fileName, lineNumber); }
+        void DescriptorDebugSizedFree(void *context, void *memory, size_t, const char *fileName, int lineNumber) { Descriptors(context).m_debugFree(memory, fileName, lineNumber); }
+
+        void* DescriptorDebugAlignedAlloc(void *context, size_t size, size_t alignment, const char *fileName, int lineNumber) { return Descriptors(context).m_debugAlignedAlloc(size, alignment, fileName, lineNumber); }
+        void* DescriptorDebugAlignedCAlloc(void *context, size_t count, size_t size, size_t alignment, const char *fileName, int lineNumber) { return Descriptors(context).m_debugAlignedCAlloc(count, size, alignment, fileName, lineNumber); }
+        void* DescriptorDebugAlignedRealloc(void *context, void *memory, size_t size, size_t alignment, const char *fileName, int lineNumber) { return Descriptors(context).m_debugAlignedRealloc(memory, size, alignment, fileName, lineNumber); }
+        void DescriptorDebugAlignedFree(void *context, void *memory, const char *fileName, int lineNumber) { Descriptors(context).m_debugAlignedFree(memory, fileName, lineNumber); }
+        void DescriptorDebugAlignedSizedFree(void *context, void *memory, size_t, size_t, const char *fileName, int lineNumber) { Descriptors(context).m_debugAlignedFree(memory, fileName, lineNumber); }
+
+        // Used when custom hooks provide an unsized free but no sized one; the block must go back to the custom hook,
+        // which belongs to the table currently dispatching (a scope's or the global one).
+        void UnsizedFree(void *context, void *memory, size_t) { Memory::GetCurrentAllocatorHooks().m_free(context, memory); }
+        void UnsizedAlignedFree(void *context, void *memory, size_t, size_t) { Memory::GetCurrentAllocatorHooks().m_alignedFree(context, memory); }
+        void UnsizedDebugFree(void *context, void *memory, size_t, const char *fileName, int lineNumber) { Memory::GetCurrentAllocatorHooks().m_debugFree(context, memory, fileName, lineNumber); }
+        void UnsizedDebugAlignedFree(void *context, void *memory, size_t, size_t, const char *fileName, int lineNumber) { Memory::GetCurrentAllocatorHooks().m_debugAlignedFree(context, memory, fileName, lineNumber); }
+
+        template <typename THook, typename TDescriptor>
+        inline THook SelectHook(const TDescriptor &descriptor, THook trampoline, THook fallback)
+        {
+            return descriptor ? trampoline : fallback;
+        }
+
+        template <typename THook>
+        inline THook SelectHook(THook hook, THook fallback)
+        {
+            return hook ? hook : fallback;
+        }
+
+        // Fills the hooks left as nullptr with the default backend.
+        void CompleteHooks(const AllocatorHooks &hooks, AllocatorHooks &completeHooks) noexcept
+        {
+            completeHooks.m_context = hooks.m_context;
+
+            completeHooks.m_alloc = SelectHook(hooks.m_alloc, g_defaultHooks.m_alloc);
+            completeHooks.m_calloc = SelectHook(hooks.m_calloc, g_defaultHooks.m_calloc);
+            completeHooks.m_realloc = SelectHook(hooks.m_realloc, g_defaultHooks.m_realloc);
+            completeHooks.m_free = SelectHook(hooks.m_free, g_defaultHooks.m_free);
+            completeHooks.m_sizedFree = SelectHook(hooks.m_sizedFree, hooks.m_free ? &UnsizedFree : g_defaultHooks.m_sizedFree);
+
+            completeHooks.m_alignedAlloc = SelectHook(hooks.m_alignedAlloc, g_defaultHooks.m_alignedAlloc);
+            completeHooks.m_alignedCAlloc = SelectHook(hooks.m_alignedCAlloc, g_defaultHooks.m_alignedCAlloc);
+            completeHooks.m_alignedRealloc = SelectHook(hooks.m_alignedRealloc, g_defaultHooks.m_alignedRealloc);
+            completeHooks.m_alignedFree = SelectHook(hooks.m_alignedFree, g_defaultHooks.m_alignedFree);
+            completeHooks.m_alignedSizedFree = SelectHook(hooks.m_alignedSizedFree, hooks.m_alignedFree ? &UnsizedAlignedFree : g_defaultHooks.m_alignedSizedFree);
+
+            completeHooks.m_debugAlloc = SelectHook(hooks.m_debugAlloc, g_defaultHooks.m_debugAlloc);
+            completeHooks.m_debugCAlloc = SelectHook(hooks.m_debugCAlloc, g_defaultHooks.m_debugCAlloc);
+            completeHooks.m_debugRealloc = SelectHook(hooks.m_debugRealloc, g_defaultHooks.m_debugRealloc);
+            completeHooks.m_debugFree = SelectHook(hooks.m_debugFree, g_defaultHooks.m_debugFree);
+            completeHooks.m_debugSizedFree = SelectHook(hooks.m_debugSizedFree, hooks.m_debugFree ? &UnsizedDebugFree : g_defaultHooks.m_debugSizedFree);
+
+            completeHooks.m_debugAlignedAlloc = SelectHook(hooks.m_debugAlignedAlloc, g_defaultHooks.m_debugAlignedAlloc);
+            completeHooks.m_debugAlignedCAlloc = SelectHook(hooks.m_debugAlignedCAlloc, g_defaultHooks.m_debugAlignedCAlloc);
+            completeHooks.m_debugAlignedRealloc = SelectHook(hooks.m_debugAlignedRealloc, g_defaultHooks.m_debugAlignedRealloc);
+            completeHooks.m_debugAlignedFree = SelectHook(hooks.m_debugAlignedFree, g_defaultHooks.m_debugAlignedFree);
+            completeHooks.m_debugAlignedSizedFree = SelectHook(hooks.m_debugAlignedSizedFree, hooks.m_debugAlignedFree ? &UnsizedDebugAlignedFree : g_defaultHooks.m_debugAlignedSizedFree);
+        }
+    }
+
     Memory::AllocatorDescriptors Memory::g_allocators;
+    AllocatorHooks Memory::g_hooks = g_defaultHooks;
+    thread_local const AllocatorHooks *Memory::t_hooks = &Memory::g_hooks;
+    thread_local Memory::ArenaScope *Memory::t_arenaScope = nullptr;
 
     void Memory::SetAllocators(Memory::AllocatorDescriptors &&allocators) noexcept
     {
         g_allocators = std::move(allocators);
+
+        AllocatorHooks hooks;
+
+        hooks.m_context = &g_allocators;
+
+        hooks.m_alloc = SelectHook(g_allocators.m_alloc, &DescriptorAlloc, g_defaultHooks.m_alloc);
+        hooks.m_calloc = SelectHook(g_allocators.m_calloc, &DescriptorCAlloc, g_defaultHooks.m_calloc);
+        hooks.m_realloc = SelectHook(g_allocators.m_realloc, &DescriptorRealloc, g_defaultHooks.m_realloc);
+        hooks.m_free = SelectHook(g_allocators.m_free, &DescriptorFree, g_defaultHooks.m_free);
+        hooks.m_sizedFree = SelectHook(g_allocators.m_free, &DescriptorSizedFree, g_defaultHooks.m_sizedFree);
+
+        hooks.m_alignedAlloc = SelectHook(g_allocators.m_alignedAlloc, &DescriptorAlignedAlloc, g_defaultHooks.m_alignedAlloc);
+        hooks.m_alignedCAlloc = SelectHook(g_allocators.m_alignedCAlloc, &DescriptorAlignedCAlloc, g_defaultHooks.m_alignedCAlloc);
+        hooks.m_alignedRealloc = SelectHook(g_allocators.m_alignedRealloc, &DescriptorAlignedRealloc, g_defaultHooks.m_alignedRealloc);
+        hooks.m_alignedFree = SelectHook(g_allocators.m_alignedFree, &DescriptorAlignedFree, g_defaultHooks.m_alignedFree);
+        hooks.m_alignedSizedFree = SelectHook(g_allocators.m_alignedFree, &DescriptorAlignedSizedFree, g_defaultHooks.m_alignedSizedFree);
+
+        hooks.m_debugAlloc = SelectHook(g_allocators.m_debugAlloc, &DescriptorDebugAlloc, g_defaultHooks.m_debugAlloc);
+        hooks.m_debugCAlloc = SelectHook(g_allocators.m_debugCAlloc, &DescriptorDebugCAlloc, g_defaultHooks.m_debugCAlloc);
+        hooks.m_debugRealloc = SelectHook(g_allocators.m_debugRealloc, &DescriptorDebugRealloc, g_defaultHooks.m_debugRealloc);
+        hooks.m_debugFree = SelectHook(g_allocators.m_debugFree, &DescriptorDebugFree, g_defaultHooks.m_debugFree);
+        hooks.m_debugSizedFree = SelectHook(g_allocators.m_debugFree, &DescriptorDebugSizedFree, g_defaultHooks.m_debugSizedFree);
+
+        hooks.m_debugAlignedAlloc = SelectHook(g_allocators.m_debugAlignedAlloc, &DescriptorDebugAlignedAlloc, g_defaultHooks.m_debugAlignedAlloc);
+        hooks.m_debugAlignedCAlloc = SelectHook(g_allocators.m_debugAlignedCAlloc, &DescriptorDebugAlignedCAlloc, g_defaultHooks.m_debugAlignedCAlloc);
+        hooks.m_debugAlignedRealloc = SelectHook(g_allocators.m_debugAlignedRealloc, &DescriptorDebugAlignedRealloc, g_defaultHooks.m_debugAlignedRealloc);
+        hooks.m_debugAlignedFree = SelectHook(g_allocators.m_debugAlignedFree, &DescriptorDebugAlignedFree, g_defaultHooks.m_debugAlignedFree);
+        hooks.m_debugAlignedSizedFree = SelectHook(g_allocators.m_debugAlignedFree, &DescriptorDebugAlignedSizedFree, g_defaultHooks.m_debugAlignedSizedFree);
+
+        g_hooks = hooks;
     }
 
-    void* Memory::Alloc(size_t size)
+    void Memory::SetAllocatorHooks(const AllocatorHooks &hooks) noexcept
     {
-        if(g_allocators.m_alloc)
-        {
-            return g_allocators.m_alloc(size);
-        }
+        AllocatorHooks completeHooks;
 
-        return std::malloc(size);
+        CompleteHooks(hooks, completeHooks);
+
+        g_hooks = completeHooks;
     }
 
-    void* Memory::CAlloc(size_t count, size_t size)
+    const AllocatorHooks& Memory::GetAllocatorHooks() noexcept
     {
-        if(g_allocators.m_calloc)
-        {
-            return g_allocators.m_calloc(count, size);
-        }
+        return g_hooks;
+    }
 
-        return std::calloc(count, size);
+    const AllocatorHooks& Memory::GetDefaultAllocatorHooks() noexcept
+    {
+        return g_defaultHooks;
     }
 
-    void* Memory::Realloc(void *memory, size_t size)
+    void* Memory::CAlloc(size_t count, size_t size)
     {
-        if(g_allocators.m_realloc)
+        if(t_arenaScope && (count == 0 || size <= SIZE_MAX / count))
         {
-            return g_allocators.m_realloc(memory, size);
+            void *memory = ArenaAlloc(count * size, 0);
+
+            if(memory)
+            {
+                std::memset(memory, 0, count * size);
+                return memory;
+            }
         }
 
-        return std::realloc(memory, size);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::CAlloc(count, size);
+#else
+        return t_hooks->m_calloc(t_hooks->m_context, count, size);
+#endif
     }
 
-    void Memory::Free(void *memory)
+    void* Memory::Realloc(void *memory, size_t size)
     {
-        if(g_allocators.m_free)
+        if(t_arenaScope)
         {
-            return g_allocators.m_free(memory);
+            MemoryArena *arena = FindArena(memory);
+
+            if(arena)
+            {
+                return ArenaRealloc(*arena, memory, size, 0);
+            }
+
+            if(!memory)
+            {
+                return Alloc(size);
+            }
         }
 
-        return std::free(memory);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::Realloc(memory, size);
+#else
+        return t_hooks->m_realloc(t_hooks->m_context, memory, size);
+#endif
     }
 
     void* Memory::AlignedAlloc(size_t size, size_t alignment)
     {
-        if(g_allocators.m_alignedAlloc)
+        if(t_arenaScope)
         {
-            return g_allocators.m_alignedAlloc(size, alignment);
+            void *memory = ArenaAlloc(size, alignment);
+
+            if(memory)
+            {
+                return memory;
+            }
         }
 
-        return ::_aligned_malloc(size, alignment);
+        return HeapAlignedAlloc(size, alignment);
     }
 
     void* Memory::AlignedCAlloc(size_t count, size_t size, size_t alignment)
     {
-        if(g_allocators.m_alignedCAlloc)
+        if(t_arenaScope && (count == 0 || size <= SIZE_MAX / count))
         {
-            return g_allocators.m_alignedCAlloc(count, size, alignment);
+            void *memory = ArenaAlloc(count * size, alignment);
+
+            if(memory)
+            {
+                std::memset(memory, 0, count * size);
+                return memory;
+            }
         }
 
-        return ::_aligned_recalloc(nullptr, count, size, alignment);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::AlignedCAlloc(count, size, alignment);
+#else
+        return t_hooks->m_alignedCAlloc(t_hooks->m_context, count, size, alignment);
+#endif
     }
 
     void* Memory::AlignedRealloc(void *memory, size_t size, size_t alignment)
     {
-        if(g_allocators.m_alignedRealloc)
+        if(t_arenaScope)
         {
-            return g_allocators.m_alignedRealloc(memory, size, alignment);
+            MemoryArena *arena = FindArena(memory);
+
+            if(arena)
+            {
+                return ArenaRealloc(*arena, memory, size, alignment);
+            }
+
+            if(!memory)
+            {
+                return AlignedAlloc(size, alignment);
+            }
         }
 
-        return ::_aligned_realloc(memory, size, alignment);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::AlignedRealloc(memory, size, alignment);
+#else
+        return t_hooks->m_alignedRealloc(t_hooks->m_context, memory, size, alignment);
+#endif
     }
 
     void Memory::AlignedFree(void *memory)
     {
-        if(g_allocators.m_alignedFree)
+        if(t_arenaScope && FindArena(memory))
         {
-            return g_allocators.m_alignedFree(memory);
+            return;
         }
 
-        return ::_aligned_free(memory);
+#ifdef DNN_ALLOCATOR_POLICY
+        DNN_ALLOCATOR_POLICY::AlignedFree(memory);
+#else
+        t_hooks->m_alignedFree(t_hooks->m_context, memory);
+#endif
     }
 
-    void* Memory::DebugAlloc(size_t size, const char *fileName, int lineNumber)
+    void Memory::AlignedFree(void *memory, size_t size, size_t alignment)
     {
-        if(g_allocators.m_debugAlloc)
+        if(t_arenaScope && FindArena(memory))
         {
-            return g_allocators.m_debugAlloc(size, fileName, lineNumber);
+            return;
         }
 
-        return ::_malloc_dbg(size, _NORMAL_BLOCK, fileName, lineNumber);
+#ifdef DNN_ALLOCATOR_POLICY
+        DNN_ALLOCATOR_POLICY::AlignedFree(memory, size, alignment);
+#else
+        t_hooks->m_alignedSizedFree(t_hooks->m_context, memory, size, alignment);
+#endif
     }
 
     void* Memory::DebugCAlloc(size_t count, size_t size, const char *fileName, int lineNumber)
     {
-        if(g_allocators.m_debugCAlloc)
+#ifdef DNN_ALLOCATION_PROFILING
+        AllocationProfiler::OnAllocation(count * size, fileName, lineNumber);
+#endif
+
+        if(t_arenaScope && (count == 0 || size <= SIZE_MAX / count))
         {
-            return g_allocators.m_debugCAlloc(count, size, fileName, lineNumber);
+            void *memory = ArenaAlloc(count * size, 0);
+
+            if(memory)
+            {
+                std::memset(memory, 0, count * size);
+                return memory;
+            }
         }
 
-        return ::_calloc_dbg(count, size, _NORMAL_BLOCK, fileName, lineNumber);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::CAlloc(count, size);
+#else
+        return t_hooks->m_debugCAlloc(t_hooks->m_context, count, size, fileName, lineNumber);
+#endif
     }
 
     void* Memory::DebugRealloc(void *memory, size_t size, const char *fileName, int lineNumber)
     {
-        if(g_allocators.m_debugRealloc)
+#ifdef DNN_ALLOCATION_PROFILING
+        AllocationProfiler::OnAllocation(size, fileName, lineNumber);
+#endif
+
+        if(t_arenaScope)
         {
-            return g_allocators.m_debugRealloc(memory, size, fileName, lineNumber);
-        }
+            MemoryArena *arena = FindArena(memory);
 
-        return ::_realloc_dbg(memory, size, _NORMAL_BLOCK, fileName, lineNumber);
-    }
+            if(arena)
+            {
+                return ArenaRealloc(*arena, memory, size, 0);
+            }
 
-    void Memory::DebugFree(void *memory, const char *fileName, int lineNumber)
-    {
-        if(g_allocators.m_debugFree)
-        {
-            return g_allocators.m_debugFree(memory, fileName, lineNumber);
+            if(!memory)
+            {
+                return DebugAlloc(size, fileName, lineNumber);
+            }
         }
 
-        return ::_free_dbg(memory, _NORMAL_BLOCK);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::Realloc(memory, size);
+#else
+        return t_hooks->m_debugRealloc(t_hooks->m_context, memory, size, fileName, lineNumber);
+#endif
     }
 
     void* Memory::DebugAlignedAlloc(size_t size, size_t alignment, const char *fileName, int lineNumber)
     {
-        if(g_allocators.m_debugAlignedAlloc)
+#ifdef DNN_ALLOCATION_PROFILING
+        AllocationProfiler::OnAllocation(size, fileName, lineNumber);
+#endif
+
+        if(t_arenaScope)
         {
-            return g_allocators.m_debugAlignedAlloc(size, alignment, fileName, lineNumber);
+            void *memory = ArenaAlloc(size, alignment);
+
+            if(memory)
+            {
+                return memory;
+            }
         }
 
-        return ::_aligned_malloc_dbg(size, alignment, fileName, lineNumber);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::AlignedAlloc(size, alignment);
+#else
+        return t_hooks->m_debugAlignedAlloc(t_hooks->m_context, size, alignment, fileName, lineNumber);
+#endif
     }
 
     void* Memory::DebugAlignedCAlloc(size_t count, size_t size, size_t alignment, const char *fileName, int lineNumber)
     {
-        if(g_allocators.m_debugAlignedCAlloc)
+#ifdef DNN_ALLOCATION_PROFILING
+        AllocationProfiler::OnAllocation(count * size, fileName, lineNumber);
+#endif
+
+        if(t_arenaScope && (count == 0 || size <= SIZE_MAX / count))
         {
-            return g_allocators.m_debugAlignedCAlloc(count, size, alignment, fileName, lineNumber);
+            void *memory = ArenaAlloc(count * size, alignment);
+
+            if(memory)
+            {
+                std::memset(memory, 0, count * size);
+                return memory;
+            }
         }
 
-        return ::_aligned_recalloc_dbg(nullptr, count, size, alignment, fileName, lineNumber);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::AlignedCAlloc(count, size, alignment);
+#else
+        return t_hooks->m_debugAlignedCAlloc(t_hooks->m_context, count, size, alignment, fileName, lineNumber);
+#endif
     }
 
     void* Memory::DebugAlignedRealloc(void *memory, size_t size, size_t alignment, const char *fileName, int lineNumber)
     {
-        if(g_allocators.m_debugAlignedRealloc)
+#ifdef DNN_ALLOCATION_PROFILING
+        AllocationProfiler::OnAllocation(size, fileName, lineNumber);
+#endif
+
+        if(t_arenaScope)
         {
-            return g_allocators.m_debugAlignedRealloc(memory, size, alignment, fileName, lineNumber);
+            MemoryArena *arena = FindArena(memory);
+
+            if(arena)
+            {
+                return ArenaRealloc(*arena, memory, size, alignment);
+            }
+
+            if(!memory)
+            {
+                return DebugAlignedAlloc(size, alignment, fileName, lineNumber);
+            }
         }
 
-        return ::_aligned_realloc_dbg(memory, size, alignment, fileName, lineNumber);
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::AlignedRealloc(memory, size, alignment);
+#else
+        return t_hooks->m_debugAlignedRealloc(t_hooks->m_context, memory, size, alignment, fileName, lineNumber);
+#endif
     }
 
     void Memory::DebugAlignedFree(void *memory, const char *fileName, int lineNumber)
     {
-        if(g_allocators.m_debugAlignedFree)
+        if(t_arenaScope && FindArena(memory))
         {
-            return g_allocators.m_debugAlignedFree(memory, fileName, lineNumber);
+            return;
         }
 
-        return ::_aligned_free_dbg(memory);
+#ifdef DNN_ALLOCATOR_POLICY
+        DNN_ALLOCATOR_POLICY::AlignedFree(memory);
+#else
+        t_hooks->m_debugAlignedFree(t_hooks->m_context, memory, fileName, lineNumber);
+#endif
+    }
+
+    void Memory::DebugAlignedFree(void *memory, size_t size, size_t alignment, const char *fileName, int lineNumber)
+    {
+        if(t_arenaScope && FindArena(memory))
+        {
+            return;
+        }
+
+#ifdef DNN_ALLOCATOR_POLICY
+        DNN_ALLOCATOR_POLICY::AlignedFree(memory, size, alignment);
+#else
+        t_hooks->m_debugAlignedSizedFree(t_hooks->m_context, memory, size, alignment, fileName, lineNumber);
+#endif
+    }
+
+    void* Memory::HeapAlignedAlloc(size_t size, size_t alignment)
+    {
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::AlignedAlloc(size, alignment);
+#else
+        return t_hooks->m_alignedAlloc(t_hooks->m_context, size, alignment);
+#endif
+    }
+
+    Memory::AllocatorScope::AllocatorScope(const AllocatorHooks &hooks) noexcept
+        : m_previous(t_hooks)
+    {
+        CompleteHooks(hooks, m_hooks);
+
+        t_hooks = &m_hooks;
+    }
+
+    Memory::AllocatorScope::~AllocatorScope() noexcept
+    {
+        t_hooks = m_previous;
     }
 }
\ No newline at end of file
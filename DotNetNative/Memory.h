@@ -1,11 +1,28 @@
 #ifndef _DOTNETNATIVE_MEMORY_H_
 #define _DOTNETNATIVE_MEMORY_H_
 
+#include "AllocatorHooks.h"
+
 #include <functional>
 #include <new>
 
+#ifdef DNN_ALLOCATOR_POLICY_HEADER
+#include DNN_ALLOCATOR_POLICY_HEADER
+#endif
+
+#ifdef DNN_ALLOCATION_PROFILING
+#include "AllocationProfiler.h"
+#endif
+
+// Debug builds, and release builds with the allocation profiler, pass the call site of every DNN_ allocation.
+#if defined(_DEBUG) || defined(DNN_ALLOCATION_PROFILING)
+#define DNN_TRACK_CALL_SITES
+#endif
+
 namespace DotNetNative
 {
+    class MemoryArena;
+
     class Memory
     {
     public:
@@ -52,49 +69,234 @@ namespace DotNetNative
             AlignedFreeDebugFn    m_debugAlignedFree;
         };
 
+        class ArenaScope;
+        class AllocatorScope;
+
     private:
+        friend class MemoryArena;
+
         static AllocatorDescriptors g_allocators;
+        static AllocatorHooks g_hooks;
+
+        // Points at g_hooks unless an AllocatorScope is active on the thread, so dispatch never branches on it.
+        static thread_local const AllocatorHooks *t_hooks;
+        static thread_local ArenaScope *t_arenaScope;
 
     private:
         Memory() = delete;
         Memory(const Memory &copy) = delete;
 
     public:
+        // Installs std::function based allocators. Prefer SetAllocatorHooks, which avoids the type-erased call.
         static void SetAllocators(AllocatorDescriptors &&allocators) noexcept;
 
+        // Hooks left as nullptr are served by the default backend, so the allocation path never tests for them.
+        // Both setters are ignored when the library is compiled with a DNN_ALLOCATOR_POLICY.
+        // Neither setter may be called while other threads allocate; use an AllocatorScope for per-thread allocators.
+        static void SetAllocatorHooks(const AllocatorHooks &hooks) noexcept;
+        static const AllocatorHooks& GetAllocatorHooks() noexcept;
+        static const AllocatorHooks& GetDefaultAllocatorHooks() noexcept;
+
+        // The hooks that serve the current thread: those of the innermost AllocatorScope, or the global hooks.
+        static const AllocatorHooks& GetCurrentAllocatorHooks() noexcept
+        {
+            return *t_hooks;
+        }
+
         static void* Alloc(size_t size);
         static void* CAlloc(size_t count, size_t size);
         static void* Realloc(void *memory, size_t size);
         static void Free(void *memory);
+        static void Free(void *memory, size_t size);
 
         static void* AlignedAlloc(size_t size, size_t alignment);
         static void* AlignedCAlloc(size_t count, size_t size, size_t alignment);
         static void* AlignedRealloc(void *memory, size_t size, size_t alignment);
         static void AlignedFree(void *memory);
+        static void AlignedFree(void *memory, size_t size, size_t alignment);
 
         static void* DebugAlloc(size_t size, const char *fileName, int lineNumber);
         static void* DebugCAlloc(size_t count, size_t size, const char *fileName, int lineNumber);
         static void* DebugRealloc(void *memory, size_t size, const char *fileName, int lineNumber);
         static void DebugFree(void *memory, const char *fileName, int lineNumber);
+        static void DebugFree(void *memory, size_t size, const char *fileName, int lineNumber);
 
         static void* DebugAlignedAlloc(size_t size, size_t alignment, const char *fileName, int lineNumber);
         static void* DebugAlignedCAlloc(size_t count, size_t size, size_t alignment, const char *fileName, int lineNumber);
         static void* DebugAlignedRealloc(void *memory, size_t size, size_t alignment, const char *fileName, int lineNumber);
         static void DebugAlignedFree(void *memory, const char *fileName, int lineNumber);
+        static void DebugAlignedFree(void *memory, size_t size, size_t alignment, const char *fileName, int lineNumber);
+
+    private:
+        // Allocations that bypass the arena scope, used for arena chunks and oversize blocks.
+        static void* HeapAlloc(size_t size);
+        static void* HeapAlignedAlloc(size_t size, size_t alignment);
+        static void HeapFree(void *memory);
+        static void HeapFree(void *memory, size_t size);
+
+        static void* ArenaAlloc(size_t size, size_t alignment) noexcept;
+        static MemoryArena* FindArena(const void *memory) noexcept;
+        static void* ArenaRealloc(MemoryArena &arena, void *memory, size_t size, size_t alignment);
     };
+
+    // Routes every Memory allocation made on the current thread to the given hooks while the scope is alive,
+    // without affecting other threads. Scopes nest and must be destroyed in reverse order of creation. Hooks
+    // left as nullptr are served by the default backend, as with SetAllocatorHooks. Blocks allocated inside a
+    // scope must be released to the same hooks, i.e. freed inside the scope or through a scope with the same hooks.
+    // Arena scopes take precedence. Ignored when the library is compiled with a DNN_ALLOCATOR_POLICY.
+    class Memory::AllocatorScope
+    {
+    private:
+        AllocatorHooks        m_hooks;
+        const AllocatorHooks *m_previous;
+
+    public:
+        explicit AllocatorScope(const AllocatorHooks &hooks) noexcept;
+        AllocatorScope(const AllocatorScope &copy) = delete;
+        AllocatorScope(AllocatorScope &&mov) = delete;
+        ~AllocatorScope() noexcept;
+
+        AllocatorScope& operator=(const AllocatorScope &copy) = delete;
+        AllocatorScope& operator=(AllocatorScope &&mov) = delete;
+
+    public:
+        const AllocatorHooks& Hooks() const noexcept
+        {
+            return m_hooks;
+        }
+    };
+
+    // The hot path is inlined into operator new and Allocator<T>. Defining DNN_ALLOCATOR_POLICY as a class with
+    // static allocation functions (see MakeAllocatorHooks) and DNN_ALLOCATOR_POLICY_HEADER as the header declaring it
+    // turns the hook dispatch into direct calls.
+    inline void* Memory::Alloc(size_t size)
+    {
+        if(t_arenaScope)
+        {
+            void *memory = ArenaAlloc(size, 0);
+
+            if(memory)
+            {
+                return memory;
+            }
+        }
+
+        return HeapAlloc(size);
+    }
+
+    inline void Memory::Free(void *memory)
+    {
+        if(t_arenaScope && FindArena(memory))
+        {
+            return;
+        }
+
+        HeapFree(memory);
+    }
+
+    // The size must be the one requested when the block was allocated or last reallocated.
+    inline void Memory::Free(void *memory, size_t size)
+    {
+        if(t_arenaScope && FindArena(memory))
+        {
+            return;
+        }
+
+        HeapFree(memory, size);
+    }
+
+    inline void* Memory::DebugAlloc(size_t size, const char *fileName, int lineNumber)
+    {
+#ifdef DNN_ALLOCATION_PROFILING
+        AllocationProfiler::OnAllocation(size, fileName, lineNumber);
+#endif
+
+        if(t_arenaScope)
+        {
+            void *memory = ArenaAlloc(size, 0);
+
+            if(memory)
+            {
+                return memory;
+            }
+        }
+
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::Alloc(size);
+#else
+        return t_hooks->m_debugAlloc(t_hooks->m_context, size, fileName, lineNumber);
+#endif
+    }
+
+    inline void Memory::DebugFree(void *memory, const char *fileName, int lineNumber)
+    {
+        if(t_arenaScope && FindArena(memory))
+        {
+            return;
+        }
+
+#ifdef DNN_ALLOCATOR_POLICY
+        DNN_ALLOCATOR_POLICY::Free(memory);
+#else
+        t_hooks->m_debugFree(t_hooks->m_context, memory, fileName, lineNumber);
+#endif
+    }
+
+    inline void Memory::DebugFree(void *memory, size_t size, const char *fileName, int lineNumber)
+    {
+        if(t_arenaScope && FindArena(memory))
+        {
+            return;
+        }
+
+#ifdef DNN_ALLOCATOR_POLICY
+        DNN_ALLOCATOR_POLICY::Free(memory, size);
+#else
+        t_hooks->m_debugSizedFree(t_hooks->m_context, memory, size, fileName, lineNumber);
+#endif
+    }
+
+    inline void* Memory::HeapAlloc(size_t size)
+    {
+#ifdef DNN_ALLOCATOR_POLICY
+        return DNN_ALLOCATOR_POLICY::Alloc(size);
+#else
+        return t_hooks->m_alloc(t_hooks->m_context, size);
+#endif
+    }
+
+    inline void Memory::HeapFree(void *memory)
+    {
+#ifdef DNN_ALLOCATOR_POLICY
+        DNN_ALLOCATOR_POLICY::Free(memory);
+#else
+        t_hooks->m_free(t_hooks->m_context, memory);
+#endif
+    }
+
+    inline void Memory::HeapFree(void *memory, size_t size)
+    {
+#ifdef DNN_ALLOCATOR_POLICY
+        DNN_ALLOCATOR_POLICY::Free(memory, size);
+#else
+        t_hooks->m_sizedFree(t_hooks->m_context, memory, size);
+#endif
+    }
 }
 
-#ifndef _DEBUG
+#ifndef DNN_TRACK_CALL_SITES
 
 #define DNN_Alloc(size) DotNetNative::Memory::Alloc(size)
 #define DNN_CAlloc(num, size) DotNetNative::Memory::CAlloc(num, size)
 #define DNN_Realloc(memory, size) DotNetNative::Memory::Realloc(memory, size)
 #define DNN_Free(memory) DotNetNative::Memory::Free(memory)
+#define DNN_SizedFree(memory, size) DotNetNative::Memory::Free(memory, size)
 
 #define DNN_AlignedAlloc(size, alignment) DotNetNative::Memory::AlignedAlloc(size, alignment)
-#define DNN_AlignedCAlloc(num, size) DotNetNative::Memory::AlignedCAlloc(num, size, alignment)
-#define DNN_AlignedRealloc(memory, size) DotNetNative::Memory::AlignedRealloc(memory, size, alignment)
+#define DNN_AlignedCAlloc(num, size, alignment) DotNetNative::Memory::AlignedCAlloc(num, size, alignment)
+#define DNN_AlignedRealloc(memory, size, alignment) DotNetNative::Memory::AlignedRealloc(memory, size, alignment)
 #define DNN_AlignedFree(memory) DotNetNative::Memory::AlignedFree(memory)
+#define DNN_AlignedSizedFree(memory, size, alignment) DotNetNative::Memory::AlignedFree(memory, size, alignment)
 
 #else
 
@@ -102,11 +304,13 @@ namespace DotNetNative
 #define DNN_CAlloc(num, size) DotNetNative::Memory::DebugCAlloc(num, size, __FILE__, __LINE__)
 #define DNN_Realloc(memory, size) DotNetNative::Memory::DebugRealloc(memory, size, __FILE__, __LINE__)
 #define DNN_Free(memory) DotNetNative::Memory::DebugFree(memory, __FILE__, __LINE__)
+#define DNN_SizedFree(memory, size) DotNetNative::Memory::DebugFree(memory, size, __FILE__, __LINE__)
 
 #define DNN_AlignedAlloc(size, alignment) DotNetNative::Memory::DebugAlignedAlloc(size, alignment, __FILE__, __LINE__)
-#define DNN_AlignedCAlloc(num, size) DotNetNative::Memory::DebugAlignedCAlloc(num, size, alignment, __FILE__, __LINE__)
-#define DNN_AlignedRealloc(memory, size) DotNetNative::Memory::DebugAlignedRealloc(memory, size, alignment, __FILE__, __LINE__)
+#define DNN_AlignedCAlloc(num, size, alignment) DotNetNative::Memory::DebugAlignedCAlloc(num, size, alignment, __FILE__, __LINE__)
+#define DNN_AlignedRealloc(memory, size, alignment) DotNetNative::Memory::DebugAlignedRealloc(memory, size, alignment, __FILE__, __LINE__)
 #define DNN_AlignedFree(memory) DotNetNative::Memory::DebugAlignedFree(memory, __FILE__, __LINE__)
+#define DNN_AlignedSizedFree(memory, size, alignment) DotNetNative::Memory::DebugAlignedFree(memory, size, alignment, __FILE__, __LINE__)
 
 #endif
 
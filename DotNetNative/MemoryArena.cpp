@@ -0,0 +1,260 @@
+#include "MemoryArena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace DotNetNative
+{
+    namespace
+    {
+        inline uintptr_t AlignUp(uintptr_t value, size_t alignment) noexcept
+        {
+            return (value + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        }
+    }
+
+    MemoryArena::MemoryArena(size_t chunkSize, size_t maxBlockSize) noexcept
+        : m_chunk(nullptr), m_cursor(0), m_end(0), m_lastBlock(0), m_nextChunkSize(0), m_maxBlockSize(maxBlockSize), m_statistics()
+    {
+        // A chunk must always be able to hold the largest block, otherwise the arena would keep growing.
+        m_nextChunkSize = std::min(std::max(chunkSize, maxBlockSize * 2 + ChunkHeaderSize), MaxChunkSize);
+        m_maxBlockSize = std::min(maxBlockSize, (m_nextChunkSize - ChunkHeaderSize) / 2);
+    }
+
+    MemoryArena::~MemoryArena() noexcept
+    {
+        Release();
+    }
+
+    void* MemoryArena::Allocate(size_t size, size_t alignment) noexcept
+    {
+        if(size == 0)
+        {
+            size = 1;
+        }
+
+        if(alignment < MinAlignment)
+        {
+            alignment = MinAlignment;
+        }
+
+        if(size > m_maxBlockSize || alignment > m_maxBlockSize)
+        {
+            ++m_statistics.m_oversizeCount;
+            m_statistics.m_oversizeBytes += size;
+            return nullptr;
+        }
+
+        uintptr_t block = AlignUp(m_cursor, alignment);
+
+        if(!m_chunk || block + size > m_end)
+        {
+            if(!AddChunk(size + alignment))
+            {
+                return nullptr;
+            }
+
+            block = AlignUp(m_cursor, alignment);
+        }
+
+        m_cursor = block + size;
+        m_lastBlock = block;
+
+        ++m_statistics.m_allocationCount;
+        m_statistics.m_allocatedBytes += size;
+        m_statistics.m_peakAllocatedBytes = std::max(m_statistics.m_peakAllocatedBytes, m_statistics.m_allocatedBytes);
+
+        return reinterpret_cast<void*>(block);
+    }
+
+    void* MemoryArena::Reallocate(void *memory, size_t size, size_t alignment) noexcept
+    {
+        if(!memory)
+        {
+            return Allocate(size, alignment);
+        }
+
+        if(size > m_maxBlockSize)
+        {
+            ++m_statistics.m_oversizeCount;
+            m_statistics.m_oversizeBytes += size;
+            return nullptr;
+        }
+
+        uintptr_t block = reinterpret_cast<uintptr_t>(memory);
+
+        if(block == m_lastBlock && block + size <= m_end && size > 0)
+        {
+            size_t oldSize = m_cursor - block;
+
+            m_cursor = block + size;
+            m_statistics.m_allocatedBytes += size - oldSize;
+            m_statistics.m_peakAllocatedBytes = std::max(m_statistics.m_peakAllocatedBytes, m_statistics.m_allocatedBytes);
+
+            return memory;
+        }
+
+        size_t available = GetAvailableSize(memory);
+        void *newMemory = Allocate(size, alignment);
+
+        if(newMemory)
+        {
+            std::memcpy(newMemory, memory, std::min(size, available));
+        }
+
+        return newMemory;
+    }
+
+    bool MemoryArena::Owns(const void *memory) const noexcept
+    {
+        return FindChunk(memory) != nullptr;
+    }
+
+    size_t MemoryArena::GetAvailableSize(const void *memory) const noexcept
+    {
+        const Chunk *chunk = FindChunk(memory);
+
+        if(!chunk)
+        {
+            return 0;
+        }
+
+        uintptr_t top = chunk == m_chunk ? m_cursor : chunk->m_top;
+
+        return top - reinterpret_cast<uintptr_t>(memory);
+    }
+
+    void MemoryArena::Release() noexcept
+    {
+        while(m_chunk)
+        {
+            Chunk *previous = m_chunk->m_previous;
+
+            Memory::HeapFree(m_chunk, m_chunk->m_end - reinterpret_cast<uintptr_t>(m_chunk));
+            m_chunk = previous;
+        }
+
+        m_cursor = 0;
+        m_end = 0;
+        m_lastBlock = 0;
+        m_statistics.m_allocatedBytes = 0;
+        m_statistics.m_chunkCount = 0;
+        m_statistics.m_reservedBytes = 0;
+    }
+
+    const MemoryArena::Chunk* MemoryArena::FindChunk(const void *memory) const noexcept
+    {
+        uintptr_t address = reinterpret_cast<uintptr_t>(memory);
+
+        // Most lookups hit the current chunk and chunk sizes grow geometrically, so the list stays short.
+        for(const Chunk *chunk = m_chunk; chunk; chunk = chunk->m_previous)
+        {
+            if(address >= chunk->m_begin && address < chunk->m_end)
+            {
+                return chunk;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool MemoryArena::AddChunk(size_t minimumSize) noexcept
+    {
+        size_t chunkSize = std::max(m_nextChunkSize, minimumSize + ChunkHeaderSize);
+        Chunk *chunk = static_cast<Chunk*>(Memory::HeapAlloc(chunkSize));
+
+        if(!chunk)
+        {
+            return false;
+        }
+
+        if(m_chunk)
+        {
+            m_chunk->m_top = m_cursor;
+        }
+
+        chunk->m_previous = m_chunk;
+        chunk->m_begin = reinterpret_cast<uintptr_t>(chunk) + ChunkHeaderSize;
+        chunk->m_end = reinterpret_cast<uintptr_t>(chunk) + chunkSize;
+        chunk->m_top = chunk->m_begin;
+
+        m_chunk = chunk;
+        m_cursor = chunk->m_begin;
+        m_end = chunk->m_end;
+        m_lastBlock = 0;
+        m_nextChunkSize = std::min(chunkSize * 2, MaxChunkSize);
+
+        ++m_statistics.m_chunkCount;
+        m_statistics.m_reservedBytes += chunkSize;
+
+        return true;
+    }
+
+    Memory::ArenaScope::ArenaScope(size_t chunkSize, size_t maxBlockSize) noexcept
+        : m_ownedArena(chunkSize, maxBlockSize), m_arena(&m_ownedArena), m_previous(t_arenaScope)
+    {
+        t_arenaScope = this;
+    }
+
+    Memory::ArenaScope::ArenaScope(MemoryArena &arena) noexcept
+        : m_ownedArena(0, 0), m_arena(&arena), m_previous(t_arenaScope)
+    {
+        t_arenaScope = this;
+    }
+
+    Memory::ArenaScope::~ArenaScope() noexcept
+    {
+        assert(t_arenaScope == this && "Arena scopes must be destroyed in reverse order of creation");
+
+        t_arenaScope = m_previous;
+    }
+
+    void* Memory::ArenaAlloc(size_t size, size_t alignment) noexcept
+    {
+        return t_arenaScope->m_arena->Allocate(size, alignment ? alignment : MemoryArena::MinAlignment);
+    }
+
+    MemoryArena* Memory::FindArena(const void *memory) noexcept
+    {
+        if(!memory)
+        {
+            return nullptr;
+        }
+
+        for(ArenaScope *scope = t_arenaScope; scope; scope = scope->m_previous)
+        {
+            if(scope->m_arena->Owns(memory))
+            {
+                return scope->m_arena;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void* Memory::ArenaRealloc(MemoryArena &arena, void *memory, size_t size, size_t alignment)
+    {
+        // An alignment of zero marks a block that is later released with Free rather than AlignedFree.
+        if(size == 0)
+        {
+            return nullptr;
+        }
+
+        void *newMemory = arena.Reallocate(memory, size, alignment ? alignment : MemoryArena::MinAlignment);
+
+        if(newMemory)
+        {
+            return newMemory;
+        }
+
+        newMemory = alignment ? HeapAlignedAlloc(size, alignment) : HeapAlloc(size);
+
+        if(newMemory)
+        {
+            std::memcpy(newMemory, memory, std::min(size, arena.GetAvailableSize(memory)));
+        }
+
+        return newMemory;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef _DOTNETNATIVE_MEMORYARENA_H_
+#define _DOTNETNATIVE_MEMORYARENA_H_
+
+#include "Memory.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DotNetNative
+{
+    // A monotonic bump allocator. Blocks are carved out of chunks obtained from the heap and are only released
+    // all at once by Release() or when the arena is destroyed; freeing an individual block is a no-op.
+    // Requests larger than the maximum block size are refused so that the caller can serve them from the heap.
+    class MemoryArena
+    {
+    public:
+        static constexpr size_t MinAlignment = 16;
+        static constexpr size_t DefaultChunkSize = 64 * 1024;
+        static constexpr size_t DefaultMaxBlockSize = 16 * 1024;
+        static constexpr size_t MaxChunkSize = 16 * 1024 * 1024;
+
+        struct Statistics
+        {
+            size_t m_allocationCount;
+            size_t m_allocatedBytes;
+            size_t m_peakAllocatedBytes;
+            size_t m_oversizeCount;
+            size_t m_oversizeBytes;
+            size_t m_chunkCount;
+            size_t m_reservedBytes;
+        };
+
+    private:
+        struct Chunk
+        {
+            Chunk     *m_previous;
+            uintptr_t  m_begin;
+            uintptr_t  m_end;
+            uintptr_t  m_top;
+        };
+
+        static constexpr size_t ChunkHeaderSize = (sizeof(Chunk) + MinAlignment - 1) & ~(MinAlignment - 1);
+
+    private:
+        Chunk      *m_chunk;
+        uintptr_t   m_cursor;
+        uintptr_t   m_end;
+        uintptr_t   m_lastBlock;
+        size_t      m_nextChunkSize;
+        size_t      m_maxBlockSize;
+        Statistics  m_statistics;
+
+    public:
+        explicit MemoryArena(size_t chunkSize = DefaultChunkSize, size_t maxBlockSize = DefaultMaxBlockSize) noexcept;
+        MemoryArena(const MemoryArena &copy) = delete;
+        MemoryArena(MemoryArena &&mov) = delete;
+        ~MemoryArena() noexcept;
+
+        MemoryArena& operator=(const MemoryArena &copy) = delete;
+        MemoryArena& operator=(MemoryArena &&mov) = delete;
+
+    public:
+        // Returns nullptr if the request is larger than the maximum block size or no chunk could be obtained.
+        void* Allocate(size_t size, size_t alignment = MinAlignment) noexcept;
+
+        // Grows or shrinks a block owned by the arena. The last block is resized in place when possible,
+        // otherwise a new block is allocated and the old contents copied. Returns nullptr if the new size
+        // must be served by the heap.
+        void* Reallocate(void *memory, size_t size, size_t alignment = MinAlignment) noexcept;
+
+        bool Owns(const void *memory) const noexcept;
+
+        // Returns the number of bytes between the block and the end of the allocated part of its chunk.
+        // A block never extends past this point so it is an upper bound for the block's size.
+        size_t GetAvailableSize(const void *memory) const noexcept;
+
+        void Release() noexcept;
+
+        const Statistics& GetStatistics() const noexcept
+        {
+            return m_statistics;
+        }
+
+    private:
+        const Chunk* FindChunk(const void *memory) const noexcept;
+        bool AddChunk(size_t minimumSize) noexcept;
+    };
+
+    // Makes an arena the target of every Memory allocation made on the current thread while the scope is alive.
+    // Scopes nest; blocks from any arena on the thread's scope stack may be freed (a no-op) or reallocated.
+    // Blocks allocated inside a scope must not be used after the scope ends.
+    class Memory::ArenaScope
+    {
+        friend class Memory;
+
+    private:
+        MemoryArena  m_ownedArena;
+        MemoryArena *m_arena;
+        ArenaScope  *m_previous;
+
+    public:
+        explicit ArenaScope(size_t chunkSize = MemoryArena::DefaultChunkSize, size_t maxBlockSize = MemoryArena::DefaultMaxBlockSize) noexcept;
+        explicit ArenaScope(MemoryArena &arena) noexcept;
+        ArenaScope(const ArenaScope &copy) = delete;
+        ArenaScope(ArenaScope &&mov) = delete;
+        ~ArenaScope() noexcept;
+
+        ArenaScope& operator=(const ArenaScope &copy) = delete;
+        ArenaScope& operator=(ArenaScope &&mov) = delete;
+
+    public:
+        MemoryArena& Arena() noexcept
+        {
+            return *m_arena;
+        }
+
+        const MemoryArena::Statistics& GetStatistics() const noexcept
+        {
+            return m_arena->GetStatistics();
+        }
+
+        static ArenaScope* Current() noexcept
+        {
+            return t_arenaScope;
+        }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "MemoryResourceAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace DotNetNative
+{
+    namespace
+    {
+        // Stored right in front of every block. m_offset is both the distance to the start of the resource's
+        // allocation and the alignment it was requested with.
+        struct BlockHeader
+        {
+            size_t m_size;
+            size_t m_offset;
+        };
+
+        constexpr size_t MinAlignment = alignof(std::max_align_t) > sizeof(BlockHeader) ? alignof(std::max_align_t) : sizeof(BlockHeader);
+
+        inline std::pmr::memory_resource& Resource(void *context) { return *static_cast<std::pmr::memory_resource*>(context); }
+
+        inline BlockHeader& Header(void *memory) { return *(static_cast<BlockHeader*>(memory) - 1); }
+
+        void* ResourceAlignedAlloc(void *context, size_t size, size_t alignment)
+        {
+            const size_t offset = std::max(alignment, MinAlignment);
+
+            if(size > SIZE_MAX - offset)
+            {
+                return nullptr;
+            }
+
+            void *block;
+
+            try
+            {
+                block = Resource(context).allocate(size + offset, offset);
+            }
+            catch(...)
+            {
+                return nullptr;
+            }
+
+            void *memory = static_cast<char*>(block) + offset;
+
+            Header(memory) = BlockHeader { size, offset };
+
+            return memory;
+        }
+
+        void ResourceFree(void *context, void *memory)
+        {
+            if(!memory)
+            {
+                return;
+            }
+
+            const BlockHeader header = Header(memory);
+
+            Resource(context).deallocate(static_cast<char*>(memory) - header.m_offset, header.m_size + header.m_offset, header.m_offset);
+        }
+
+        void* ResourceAlignedCAlloc(void *context, size_t count, size_t size, size_t alignment)
+        {
+            if(count != 0 && size > SIZE_MAX / count)
+            {
+                return nullptr;
+            }
+
+            void *memory = ResourceAlignedAlloc(context, count * size, alignment);
+
+            if(memory)
+            {
+                std::memset(memory, 0, count * size);
+            }
+
+            return memory;
+        }
+
+        void* ResourceAlignedRealloc(void *context, void *memory, size_t size, size_t alignment)
+        {
+            if(!memory)
+            {
+                return ResourceAlignedAlloc(context, size, alignment);
+            }
+
+            const size_t oldSize = Header(memory).m_size;
+
+            // The resource must get back the exact size it handed out, so blocks are never resized in place.
+            if(size == oldSize && Header(memory).m_offset >= alignment)
+            {
+                return memory;
+            }
+
+            void *newMemory = ResourceAlignedAlloc(context, size, alignment);
+
+            if(newMemory)
+            {
+                std::memcpy(newMemory, memory, std::min(size, oldSize));
+                ResourceFree(context, memory);
+            }
+
+            return newMemory;
+        }
+
+        void* ResourceAlloc(void *context, size_t size) { return ResourceAlignedAlloc(context, size, MinAlignment); }
+        void* ResourceCAlloc(void *context, size_t count, size_t size) { return ResourceAlignedCAlloc(context, count, size, MinAlignment); }
+        void* ResourceRealloc(void *context, void *memory, size_t size) { return ResourceAlignedRealloc(context, memory, size, MinAlignment); }
+        void ResourceSizedFree(void *context, void *memory, size_t) { ResourceFree(context, memory); }
+        void ResourceAlignedSizedFree(void *context, void *memory, size_t, size_t) { ResourceFree(context, memory); }
+
+        void* ResourceDebugAlloc(void *context, size_t size, const char*, int) { return ResourceAlloc(context, size); }
+        void* ResourceDebugCAlloc(void *context, size_t count, size_t size, const char*, int) { return ResourceCAlloc(context, count, size); }
+        void* ResourceDebugRealloc(void *context, void *memory, size_t size, const char*, int) { return ResourceRealloc(context, memory, size); }
+        void ResourceDebugFree(void *context, void *memory, const char*, int) { ResourceFree(context, memory); }
+        void ResourceDebugSizedFree(void *context, void *memory, size_t, const char*, int) { ResourceFree(context, memory); }
+
+        void* ResourceDebugAlignedAlloc(void *context, size_t size, size_t alignment, const char*, int) { return ResourceAlignedAlloc(context, size, alignment); }
+        void* ResourceDebugAlignedCAlloc(void *context, size_t count, size_t size, size_t alignment, const char*, int) { return ResourceAlignedCAlloc(context, count, size, alignment); }
+        void* ResourceDebugAlignedRealloc(void *context, void *memory, size_t size, size_t alignment, const char*, int) { return ResourceAlignedRealloc(context, memory, size, alignment); }
+        void ResourceDebugAlignedFree(void *context, void *memory, const char*, int) { ResourceFree(context, memory); }
+        void ResourceDebugAlignedSizedFree(void *context, void *memory, size_t, size_t, const char*, int) { ResourceFree(context, memory); }
+    }
+
+    AllocatorHooks MemoryResourceAllocator::CreateHooks(std::pmr::memory_resource &resource) noexcept
+    {
+        return AllocatorHooks
+        {
+            &resource,
+
+            &ResourceAlloc,
+            &ResourceCAlloc,
+            &ResourceRealloc,
+            &ResourceFree,
+            &ResourceSizedFree,
+
+            &ResourceAlignedAlloc,
+            &ResourceAlignedCAlloc,
+            &ResourceAlignedRealloc,
+            &ResourceFree,
+            &ResourceAlignedSizedFree,
+
+            &ResourceDebugAlloc,
+            &ResourceDebugCAlloc,
+            &ResourceDebugRealloc,
+            &ResourceDebugFree,
+            &ResourceDebugSizedFree,
+
+            &ResourceDebugAlignedAlloc,
+            &ResourceDebugAlignedCAlloc,
+            &ResourceDebugAlignedRealloc,
+            &ResourceDebugAlignedFree,
+            &ResourceDebugAlignedSizedFree
+        };
+    }
+}
\ No newline at end of file
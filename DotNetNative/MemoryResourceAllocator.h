@@ -0,0 +1,32 @@
+#ifndef _DOTNETNATIVE_MEMORYRESOURCEALLOCATOR_H_
+#define _DOTNETNATIVE_MEMORYRESOURCEALLOCATOR_H_
+
+#include "AllocatorHooks.h"
+
+#include <memory_resource>
+
+namespace DotNetNative
+{
+    // Serves Memory's allocation functions from a std::pmr::memory_resource, so that Array, Dictionary and String
+    // storage can share the monotonic and pool resources of pmr containers. Install the hooks for a thread with
+    // Memory::AllocatorScope (or globally with Memory::SetAllocatorHooks); the resource must outlive every block.
+    //
+    // A memory_resource needs the size and alignment of a block to release it, while Memory::Free does not know
+    // them, so every block is preceded by a small header of max(alignment, alignof(std::max_align_t)) bytes.
+    // Allocation failures are reported as nullptr, like the C runtime.
+    //
+    // To go the other way, construct an Allocator<T> over the resource (see DNN_ResourceAllocator).
+    class MemoryResourceAllocator
+    {
+    private:
+        MemoryResourceAllocator() = delete;
+        MemoryResourceAllocator(const MemoryResourceAllocator &copy) = delete;
+        MemoryResourceAllocator(MemoryResourceAllocator &&mov) = delete;
+        ~MemoryResourceAllocator() = delete;
+
+    public:
+        static AllocatorHooks CreateHooks(std::pmr::memory_resource &resource) noexcept;
+    };
+}
+
+#endif
\ No newline at end of file
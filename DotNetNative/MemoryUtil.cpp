@@ -32,7 +32,7 @@ _VCRT_ALLOCATOR void* operator new(size_t size, std::nothrow_t const&) noexcept
 _Ret_notnull_ _Post_writable_byte_size_(size)
 _VCRT_ALLOCATOR void* operator new(size_t size, const char *fileName, int lineNumber)
 {
-#ifdef _DEBUG
+#ifdef DNN_TRACK_CALL_SITES
     void *memory = DotNetNative::Memory::DebugAlloc(size, fileName, lineNumber);
 #else
     void *memory = DotNetNative::Memory::Alloc(size);
@@ -46,6 +46,24 @@ _VCRT_ALLOCATOR void* operator new(size_t size, const char *fileName, int lineNu
     return memory;
 }
 
+_Ret_notnull_ _Post_writable_byte_size_(size)
+_VCRT_ALLOCATOR void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+_Ret_maybenull_ _Success_(return != NULL) _Post_writable_byte_size_(size)
+_VCRT_ALLOCATOR void* operator new[](size_t size, std::nothrow_t const &tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+_Ret_notnull_ _Post_writable_byte_size_(size)
+_VCRT_ALLOCATOR void* operator new[](size_t size, const char *fileName, int lineNumber)
+{
+    return operator new(size, fileName, lineNumber);
+}
+
 void operator delete(void *memory)
 {
 #ifdef _DEBUG
@@ -55,13 +73,37 @@ void operator delete(void *memory)
 #endif
 }
 
-void operator delete(void *memory, const char *fileName, int lineNumber)
+void operator delete(void *memory, size_t size)
 {
 #ifdef _DEBUG
+    DotNetNative::Memory::DebugFree(memory, size, __FILE__, __LINE__);
+#else
+    DotNetNative::Memory::Free(memory, size);
+#endif
+}
+
+void operator delete(void *memory, const char *fileName, int lineNumber)
+{
+#ifdef DNN_TRACK_CALL_SITES
     DotNetNative::Memory::DebugFree(memory, fileName, lineNumber);
 #else
     DotNetNative::Memory::Free(memory);
 #endif
 }
 
+void operator delete[](void *memory)
+{
+    operator delete(memory);
+}
+
+void operator delete[](void *memory, size_t size)
+{
+    operator delete(memory, size);
+}
+
+void operator delete[](void *memory, const char *fileName, int lineNumber)
+{
+    operator delete(memory, fileName, lineNumber);
+}
+
 #endif
\ No newline at end of file
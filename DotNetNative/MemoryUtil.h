@@ -3,6 +3,7 @@
 
 #include "Memory.h"
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include <vcruntime_new.h>
 
@@ -24,13 +25,30 @@ _VCRT_ALLOCATOR void* operator new(size_t size, std::nothrow_t const&) noexcept;
 _Ret_notnull_ _Post_writable_byte_size_(size)
 _VCRT_ALLOCATOR void* operator new(size_t size, const char *fileName, int lineNumber);
 
+_Ret_notnull_ _Post_writable_byte_size_(size)
+_VCRT_ALLOCATOR void* operator new[](size_t size);
+
+_Ret_maybenull_ _Success_(return != NULL) _Post_writable_byte_size_(size)
+_VCRT_ALLOCATOR void* operator new[](size_t size, std::nothrow_t const&) noexcept;
+
+_Ret_notnull_ _Post_writable_byte_size_(size)
+_VCRT_ALLOCATOR void* operator new[](size_t size, const char *fileName, int lineNumber);
+
 void operator delete(void *memory);
 
+void operator delete(void *memory, size_t size);
+
 void operator delete(void *memory, const char *fileName, int lineNumber);
 
+void operator delete[](void *memory);
+
+void operator delete[](void *memory, size_t size);
+
+void operator delete[](void *memory, const char *fileName, int lineNumber);
+
 #endif
 
-#ifndef _DEBUG
+#ifndef DNN_TRACK_CALL_SITES
 #define DNN_New new
 #else
 #define DNN_New new(__FILE__, __LINE__)
@@ -40,6 +58,9 @@ namespace DotNetNative
 {
     /////////////////////////////////////////////////////// Allocator ///////////////////////////////////////////////////////
 
+    // Allocates through Memory, or through a std::pmr::memory_resource when constructed over one. Allocators over
+    // different resources do not compare equal, and containers keep their resource when assigned, as with
+    // std::pmr::polymorphic_allocator.
     template <typename T>
     class Allocator
     {
@@ -47,36 +68,48 @@ namespace DotNetNative
         friend class Allocator;
 
     private:
-#ifdef _DEBUG
-        const char *m_fileName;
-        int         m_lineNumber;
+        std::pmr::memory_resource *m_resource;
+#ifdef DNN_TRACK_CALL_SITES
+        const char                *m_fileName;
+        int                        m_lineNumber;
 #endif
 
     public:
         typedef T value_type;
 
-#if _DEBUG
+#ifdef DNN_TRACK_CALL_SITES
         Allocator(const char *fileName, const int lineNumber) noexcept
-            : m_fileName(fileName)
+            : m_resource(nullptr)
+            , m_fileName(fileName)
+            , m_lineNumber(lineNumber)
+        {
+        }
+
+        Allocator(std::pmr::memory_resource *resource, const char *fileName, const int lineNumber) noexcept
+            : m_resource(resource)
+            , m_fileName(fileName)
             , m_lineNumber(lineNumber)
         {
         }
 
         Allocator(const Allocator<T> &alloc) noexcept
-            : m_fileName(alloc.m_fileName)
+            : m_resource(alloc.m_resource)
+            , m_fileName(alloc.m_fileName)
             , m_lineNumber(alloc.m_lineNumber)
         {
         }
 
         Allocator(Allocator<T> &&alloc) noexcept
-            : m_fileName(alloc.m_fileName)
+            : m_resource(alloc.m_resource)
+            , m_fileName(alloc.m_fileName)
             , m_lineNumber(alloc.m_lineNumber)
         {
         }
 
         template <typename Other>
         Allocator(const Allocator<Other> &alloc) noexcept
-            : m_fileName(alloc.m_fileName)
+            : m_resource(alloc.m_resource)
+            , m_fileName(alloc.m_fileName)
             , m_lineNumber(alloc.m_lineNumber)
         {
         }
@@ -85,8 +118,9 @@ namespace DotNetNative
         {
             if(this != &alloc)
             {
+                m_resource = alloc.m_resource;
                 m_fileName = alloc.m_fileName;
-                m_lineNumber = alloc.m_fileName;
+                m_lineNumber = alloc.m_lineNumber;
             }
 
             return *this;
@@ -96,23 +130,40 @@ namespace DotNetNative
         {
             if(this != &alloc)
             {
+                m_resource = alloc.m_resource;
                 m_fileName = alloc.m_fileName;
-                m_lineNumber = alloc.m_fileName;
+                m_lineNumber = alloc.m_lineNumber;
             }
 
             return *this;
         }
 #else
-        Allocator() noexcept {}
+        Allocator() noexcept
+            : m_resource(nullptr)
+        {
+        }
+
+        explicit Allocator(std::pmr::memory_resource *resource) noexcept
+            : m_resource(resource)
+        {
+        }
 
         template <typename Other>
-        Allocator(const Allocator<Other> &alloc) noexcept {}
+        Allocator(const Allocator<Other> &alloc) noexcept
+            : m_resource(alloc.m_resource)
+        {
+        }
 #endif
 
         // [[nodiscard]]
         T* allocate(size_t count)
         {
-#if _DEBUG
+            if(m_resource)
+            {
+                return static_cast<T*>(m_resource->allocate(sizeof(T) * count, alignof(T)));
+            }
+
+#ifdef DNN_TRACK_CALL_SITES
             return static_cast<T*>(Memory::DebugAlloc(sizeof(T) * count, m_fileName, m_lineNumber));
 #else
             return static_cast<T*>(Memory::Alloc(sizeof(T) * count));
@@ -121,20 +172,38 @@ namespace DotNetNative
 
         void deallocate(T *memory, size_t count)
         {
-            delete memory;
+            if(m_resource)
+            {
+                m_resource->deallocate(memory, sizeof(T) * count, alignof(T));
+                return;
+            }
+
+#ifdef DNN_TRACK_CALL_SITES
+            Memory::DebugFree(memory, sizeof(T) * count, m_fileName, m_lineNumber);
+#else
+            Memory::Free(memory, sizeof(T) * count);
+#endif
+        }
+
+        // Returns nullptr when the allocator uses Memory.
+        std::pmr::memory_resource* Resource() const noexcept
+        {
+            return m_resource;
         }
     };
 
-#ifdef _DEBUG
+#ifdef DNN_TRACK_CALL_SITES
 #define DNN_Allocator(type) DotNetNative::Allocator<type>(__FILE__, __LINE__)
+#define DNN_ResourceAllocator(type, resource) DotNetNative::Allocator<type>(resource, __FILE__, __LINE__)
 #else
 #define DNN_Allocator(type) DotNetNative::Allocator<type>()
+#define DNN_ResourceAllocator(type, resource) DotNetNative::Allocator<type>(resource)
 #endif
 
     template <typename T, typename U>
-    inline bool operator == (const Allocator<T>&, const Allocator<U>&)
+    inline bool operator == (const Allocator<T> &a, const Allocator<U> &b)
     {
-        return true;
+        return a.Resource() == b.Resource() || (a.Resource() && b.Resource() && a.Resource()->is_equal(*b.Resource()));
     }
 
     template <typename T, typename U>
@@ -177,15 +246,32 @@ namespace DotNetNative
         }
     };
 
+    // Releases trivial elements allocated with DNN_Alloc and hands the block size back to the allocator.
+    template <typename T>
+    struct SizedFreeDeleter
+    {
+        size_t m_size;
+
+        void operator()(std::remove_extent_t<T> *memory) const noexcept
+        {
+            static_assert(std::is_trivial<std::remove_extent_t<T>>::value, "can't free a non-trivial type");
+
+            DNN_SizedFree(memory, m_size);
+        }
+    };
+
     /////////////////////////////////////////////////////// Util Functions ///////////////////////////////////////////////////////
 
     template <typename T>
     using unique_ptr = std::unique_ptr<T, Deleter<T>>;
 
+    template <typename T>
+    using sized_unique_ptr = std::unique_ptr<T, SizedFreeDeleter<T>>;
+
     template <typename T>
     using shared_ptr = std::shared_ptr<T>;
 
-#ifdef _DEBUG
+#ifdef DNN_TRACK_CALL_SITES
 
 #define DNN_make_unique(type, ...) DotNetNative::make_unique<type>(__FILE__, __LINE__, __VA_ARGS__)
 #define DNN_make_unique_array(type, size) DotNetNative::make_unique<type>(size, __FILE__, __LINE__)
@@ -229,7 +315,7 @@ namespace DotNetNative
 
 #endif
 
-#ifdef _DEBUG
+#ifdef DNN_TRACK_CALL_SITES
 
 #define DNN_make_shared(type, ...) DotNetNative::make_shared<type>(__FILE__, __LINE__, __VA_ARGS__)
 #define DNN_make_shared_array(type, size) DotNetNative::make_shared<type>(size, __FILE__, __LINE__)
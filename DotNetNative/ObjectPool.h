@@ -0,0 +1,360 @@
+#ifndef _DOTNETNATIVE_OBJECTPOOL_H_
+#define _DOTNETNATIVE_OBJECTPOOL_H_
+
+#include "Memory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace DotNetNative
+{
+    // The default ObjectPool policy: returned objects are destroyed and only their storage is reused.
+    template <typename T>
+    struct ObjectPoolPolicy
+    {
+        // Objects cached by each thread. When a thread's list is full, half of it moves to the shared list.
+        static constexpr size_t ThreadCapacity = 32;
+
+        // Objects kept in the shared overflow list, which refills empty thread lists. Further objects are released.
+        static constexpr size_t SharedCapacity = 256;
+
+        // When false, returned objects stay constructed and are handed out again by Acquire after Reset.
+        static constexpr bool DestroyOnReturn = true;
+
+        static void Reset(T &object) noexcept
+        {
+        }
+    };
+
+    // Keeps returned objects constructed and calls their Reset() method before they are handed out again.
+    template <typename T>
+    struct ResetOnReturnPolicy : ObjectPoolPolicy<T>
+    {
+        static constexpr bool DestroyOnReturn = false;
+
+        static void Reset(T &object)
+        {
+            object.Reset();
+        }
+    };
+
+    // A pool of objects of a single type, shared by all threads. Each thread takes and returns objects through a
+    // bounded free list of its own and only locks the shared overflow list to move half a list at a time, so
+    // objects may be released on another thread than the one that acquired them. The lists of an exiting thread
+    // move to the shared list.
+    //
+    // Storage comes from Memory's default backend, bypassing arenas, allocator scopes and installed hooks, because
+    // a pooled block outlives the call that allocated it. The pool itself is never destroyed.
+    template <typename T, typename TPolicy = ObjectPoolPolicy<T>>
+    class ObjectPool
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "ObjectPool does not support over-aligned types.");
+        static_assert(TPolicy::ThreadCapacity >= 2, "The thread list must hold at least two objects.");
+
+    private:
+        struct SharedList
+        {
+            std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+            size_t           m_count = 0;
+            void            *m_items[TPolicy::SharedCapacity] = {};
+        };
+
+        struct ThreadList
+        {
+            size_t  m_count = 0;
+            void   *m_items[TPolicy::ThreadCapacity] = {};
+
+            ~ThreadList()
+            {
+                MoveToShared(*this, m_count);
+            }
+        };
+
+        // Constant-initialized and trivially destructible, so it can be used from static initializers and destructors.
+        static SharedList g_shared;
+
+    private:
+        ObjectPool() = delete;
+        ObjectPool(const ObjectPool &copy) = delete;
+        ObjectPool(ObjectPool &&mov) = delete;
+        ~ObjectPool() = delete;
+
+        static ThreadList& GetThreadList() noexcept
+        {
+            thread_local ThreadList t_list;
+
+            return t_list;
+        }
+
+        static void LockShared() noexcept
+        {
+            int spins = 0;
+
+            while(g_shared.m_lock.test_and_set(std::memory_order_acquire))
+            {
+                if(++spins > 64)
+                {
+                    std::this_thread::yield();
+                    spins = 0;
+                }
+            }
+        }
+
+        static void UnlockShared() noexcept
+        {
+            g_shared.m_lock.clear(std::memory_order_release);
+        }
+
+        static void* AllocateBlock()
+        {
+            const AllocatorHooks &hooks = Memory::GetDefaultAllocatorHooks();
+            void *block = hooks.m_alloc(hooks.m_context, sizeof(T));
+
+            if(!block)
+            {
+                throw std::bad_alloc();
+            }
+
+            return block;
+        }
+
+        static void ReleaseItem(void *item) noexcept
+        {
+            if constexpr(!TPolicy::DestroyOnReturn)
+            {
+                static_cast<T*>(item)->~T();
+            }
+
+            const AllocatorHooks &hooks = Memory::GetDefaultAllocatorHooks();
+
+            hooks.m_sizedFree(hooks.m_context, item, sizeof(T));
+        }
+
+        // Moves the last 'count' items of the thread list to the shared list and releases the ones that don't fit.
+        static void MoveToShared(ThreadList &list, size_t count) noexcept
+        {
+            size_t index = list.m_count - count;
+
+            LockShared();
+
+            while(index < list.m_count && g_shared.m_count < TPolicy::SharedCapacity)
+            {
+                g_shared.m_items[g_shared.m_count++] = list.m_items[index++];
+            }
+
+            UnlockShared();
+
+            while(index < list.m_count)
+            {
+                ReleaseItem(list.m_items[index++]);
+            }
+
+            list.m_count -= count;
+        }
+
+        static void* Pop() noexcept
+        {
+            ThreadList &list = GetThreadList();
+
+            if(list.m_count == 0)
+            {
+                LockShared();
+
+                while(list.m_count < TPolicy::ThreadCapacity / 2 && g_shared.m_count > 0)
+                {
+                    list.m_items[list.m_count++] = g_shared.m_items[--g_shared.m_count];
+                }
+
+                UnlockShared();
+
+                if(list.m_count == 0)
+                {
+                    return nullptr;
+                }
+            }
+
+            return list.m_items[--list.m_count];
+        }
+
+        static void Push(void *item) noexcept
+        {
+            ThreadList &list = GetThreadList();
+
+            if(list.m_count == TPolicy::ThreadCapacity)
+            {
+                MoveToShared(list, TPolicy::ThreadCapacity / 2);
+            }
+
+            list.m_items[list.m_count++] = item;
+        }
+
+    public:
+        // Returns a pooled object. With DestroyOnReturn the object is constructed from the arguments in reused
+        // storage, otherwise a previously released object is returned as is and new objects are default-constructed.
+        template <typename... TArgs>
+        static T* Acquire(TArgs&&... args)
+        {
+            if constexpr(TPolicy::DestroyOnReturn)
+            {
+                void *block = Allocate();
+
+                try
+                {
+                    return ::new (block) T(std::forward<TArgs>(args)...);
+                }
+                catch(...)
+                {
+                    Deallocate(block);
+                    throw;
+                }
+            }
+            else
+            {
+                static_assert(sizeof...(TArgs) == 0, "Objects kept by the pool are reused as they are and can't be constructed from arguments.");
+
+                if(void *item = Pop())
+                {
+                    return static_cast<T*>(item);
+                }
+
+                void *block = AllocateBlock();
+
+                try
+                {
+                    return ::new (block) T();
+                }
+                catch(...)
+                {
+                    const AllocatorHooks &hooks = Memory::GetDefaultAllocatorHooks();
+
+                    hooks.m_sizedFree(hooks.m_context, block, sizeof(T));
+                    throw;
+                }
+            }
+        }
+
+        static void Release(T *object)
+        {
+            if(!object)
+            {
+                return;
+            }
+
+            if constexpr(TPolicy::DestroyOnReturn)
+            {
+                object->~T();
+                Deallocate(object);
+            }
+            else
+            {
+                TPolicy::Reset(*object);
+                Push(object);
+            }
+        }
+
+        // Raw storage for one T, for class-specific operator new and delete (see PooledObject). Only available with
+        // pools that destroy returned objects.
+        static void* Allocate()
+        {
+            static_assert(TPolicy::DestroyOnReturn, "Storage can only be taken from pools that destroy returned objects.");
+
+            void *block = Pop();
+
+            return block ? block : AllocateBlock();
+        }
+
+        static void Deallocate(void *memory) noexcept
+        {
+            static_assert(TPolicy::DestroyOnReturn, "Storage can only be returned to pools that destroy returned objects.");
+
+            if(memory)
+            {
+                Push(memory);
+            }
+        }
+
+        // Releases the objects cached by the calling thread and in the shared list.
+        static void Clear() noexcept
+        {
+            ThreadList &list = GetThreadList();
+
+            while(list.m_count > 0)
+            {
+                ReleaseItem(list.m_items[--list.m_count]);
+            }
+
+            LockShared();
+
+            const size_t count = g_shared.m_count;
+            void *items[TPolicy::SharedCapacity];
+
+            for(size_t i = 0; i < count; ++i)
+            {
+                items[i] = g_shared.m_items[i];
+            }
+
+            g_shared.m_count = 0;
+
+            UnlockShared();
+
+            for(size_t i = 0; i < count; ++i)
+            {
+                ReleaseItem(items[i]);
+            }
+        }
+
+        static size_t GetThreadCachedCount() noexcept
+        {
+            return GetThreadList().m_count;
+        }
+
+        static size_t GetSharedCachedCount() noexcept
+        {
+            LockShared();
+
+            const size_t count = g_shared.m_count;
+
+            UnlockShared();
+
+            return count;
+        }
+    };
+
+    template <typename T, typename TPolicy>
+    typename ObjectPool<T, TPolicy>::SharedList ObjectPool<T, TPolicy>::g_shared;
+
+    // Deriving a final class T from PooledObject<T> makes new and delete of T go through ObjectPool<T>, so that
+    // pooled objects can be handed out as unique_ptr to a base class with a virtual destructor.
+    template <typename T, typename TPolicy = ObjectPoolPolicy<T>>
+    class PooledObject
+    {
+    public:
+        static void* operator new(size_t size)
+        {
+            static_assert(std::is_final_v<T>, "Pooled objects must be final so that every instance fits the pool's blocks.");
+
+            return ObjectPool<T, TPolicy>::Allocate();
+        }
+
+        static void* operator new(size_t size, const char *fileName, int lineNumber)
+        {
+            return operator new(size);
+        }
+
+        static void operator delete(void *memory) noexcept
+        {
+            ObjectPool<T, TPolicy>::Deallocate(memory);
+        }
+
+        static void operator delete(void *memory, const char *fileName, int lineNumber) noexcept
+        {
+            ObjectPool<T, TPolicy>::Deallocate(memory);
+        }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,771 @@
+#include "SizeClassAllocator.h"
+#include "LargeAllocator.h"
+#include "Memory.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <malloc.h>
+#endif
+
+namespace DotNetNative
+{
+    namespace
+    {
+        static constexpr size_t SlabHeaderSize = 64;
+        static constexpr uint32_t SlabMagic = 0x534c4142; // 'SLAB'
+        static constexpr int MaxRegions = 256;
+
+        static constexpr size_t SizeClasses[SizeClassAllocator::SizeClassCount] =
+        {
+            16,   32,   48,   64,   80,   96,   112,  128,
+            160,  192,  224,  256,  320,  384,  448,  512,
+            640,  768,  896,  1024, 1280, 1536, 1792, 2048,
+            2560, 3072, 3584, 4096, 5120, 6144, 7168, 8192
+        };
+
+        static constexpr size_t SizeClassLookupSize = (SizeClassAllocator::MaxSmallSize >> 4) + 1;
+
+        struct SizeClassLookup
+        {
+            uint8_t m_classes[SizeClassLookupSize];
+
+            constexpr SizeClassLookup()
+                : m_classes()
+            {
+                int sizeClass = 0;
+
+                for(size_t i = 0; i < SizeClassLookupSize; ++i)
+                {
+                    while(SizeClasses[sizeClass] < (i << 4))
+                    {
+                        ++sizeClass;
+                    }
+
+                    m_classes[i] = static_cast<uint8_t>(sizeClass);
+                }
+            }
+        };
+
+        static constexpr SizeClassLookup g_sizeClassLookup;
+
+        struct FreeBlock
+        {
+            FreeBlock *m_next;
+        };
+
+        struct SlabHeader
+        {
+            uint32_t m_magic;
+            uint32_t m_sizeClass;
+        };
+
+        static_assert(sizeof(SlabHeader) <= SlabHeaderSize, "SlabHeader must fit in the reserved slab header space.");
+
+        // The header stored in front of aligned blocks so they can be released and resized without knowing where they came from.
+        struct AlignedHeader
+        {
+            void   *m_block;
+            size_t  m_size;
+        };
+
+        class SpinLock
+        {
+        private:
+            std::atomic_flag m_flag = ATOMIC_FLAG_INIT;
+
+        public:
+            void Lock() noexcept
+            {
+                int spins = 0;
+
+                while(m_flag.test_and_set(std::memory_order_acquire))
+                {
+                    if(++spins > 64)
+                    {
+                        std::this_thread::yield();
+                        spins = 0;
+                    }
+                }
+            }
+
+            void Unlock() noexcept
+            {
+                m_flag.clear(std::memory_order_release);
+            }
+        };
+
+        class SpinLockGuard
+        {
+        private:
+            SpinLock &m_lock;
+
+        public:
+            explicit SpinLockGuard(SpinLock &lock) noexcept : m_lock(lock) { m_lock.Lock(); }
+            ~SpinLockGuard() { m_lock.Unlock(); }
+
+            SpinLockGuard(const SpinLockGuard &copy) = delete;
+            SpinLockGuard& operator=(const SpinLockGuard &copy) = delete;
+        };
+
+        struct Region
+        {
+            std::atomic<uintptr_t> m_begin{ 0 };
+            std::atomic<uintptr_t> m_end{ 0 };
+        };
+
+        // Shared state for a single size class: a free list of returned blocks and the unused tail of the last slab.
+        struct CentralClass
+        {
+            SpinLock   m_lock;
+            FreeBlock *m_freeList = nullptr;
+            size_t     m_freeCount = 0;
+            uintptr_t  m_bumpPointer = 0;
+            uintptr_t  m_bumpEnd = 0;
+        };
+
+        struct Depot
+        {
+            CentralClass          m_classes[SizeClassAllocator::SizeClassCount];
+            Region                m_regions[MaxRegions];
+            std::atomic<int>      m_regionCount{ 0 };
+            SpinLock              m_regionLock;
+            uintptr_t             m_regionCursor = 0;
+            uintptr_t             m_regionEnd = 0;
+            std::atomic<size_t>   m_slabCount{ 0 };
+        };
+
+        // Constant-initialized, so it is usable from static initializers and thread-exit handlers alike.
+        static Depot g_depot;
+
+        inline size_t BatchSize(const int sizeClass) noexcept
+        {
+            const size_t count = (32 * 1024) / SizeClasses[sizeClass];
+
+            return count < 2 ? 2 : (count > 64 ? 64 : count);
+        }
+
+        inline SlabHeader* GetSlabHeader(const void *memory) noexcept
+        {
+            return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(memory) & ~(SizeClassAllocator::SlabSize - 1));
+        }
+
+        void* ReserveRegion() noexcept
+        {
+#ifdef _WIN32
+            // Reservations are aligned to the 64KB allocation granularity which matches SlabSize.
+            static_assert(SizeClassAllocator::SlabSize == 64 * 1024, "Slabs must match the Windows allocation granularity.");
+
+            return ::VirtualAlloc(nullptr, SizeClassAllocator::RegionSize, MEM_RESERVE, PAGE_NOACCESS);
+#else
+            const size_t mapSize = SizeClassAllocator::RegionSize + SizeClassAllocator::SlabSize;
+            void *mapping = ::mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+            if(mapping == MAP_FAILED)
+            {
+                return nullptr;
+            }
+
+            // Trim the mapping so the region starts on a slab boundary.
+            const uintptr_t base = reinterpret_cast<uintptr_t>(mapping);
+            const uintptr_t aligned = (base + SizeClassAllocator::SlabSize - 1) & ~(SizeClassAllocator::SlabSize - 1);
+            const size_t head = aligned - base;
+            const size_t tail = SizeClassAllocator::SlabSize - head;
+
+            if(head > 0)
+            {
+                ::munmap(mapping, head);
+            }
+
+            if(tail > 0)
+            {
+                ::munmap(reinterpret_cast<void*>(aligned + SizeClassAllocator::RegionSize), tail);
+            }
+
+            return reinterpret_cast<void*>(aligned);
+#endif
+        }
+
+        bool CommitSlab(void *slab) noexcept
+        {
+#ifdef _WIN32
+            return ::VirtualAlloc(slab, SizeClassAllocator::SlabSize, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+            (void)slab;
+
+            return true;
+#endif
+        }
+
+        // Carves a new slab out of the current region, reserving a new region when the current one is exhausted.
+        void* AllocateSlab(const int sizeClass) noexcept
+        {
+            void *slab = nullptr;
+
+            {
+                SpinLockGuard guard(g_depot.m_regionLock);
+
+                if(g_depot.m_regionCursor == g_depot.m_regionEnd)
+                {
+                    const int regionCount = g_depot.m_regionCount.load(std::memory_order_relaxed);
+
+                    if(regionCount >= MaxRegions)
+                    {
+                        return nullptr;
+                    }
+
+                    void *region = ReserveRegion();
+
+                    if(!region)
+                    {
+                        return nullptr;
+                    }
+
+                    g_depot.m_regionCursor = reinterpret_cast<uintptr_t>(region);
+                    g_depot.m_regionEnd = g_depot.m_regionCursor + SizeClassAllocator::RegionSize;
+
+                    g_depot.m_regions[regionCount].m_begin.store(g_depot.m_regionCursor, std::memory_order_relaxed);
+                    g_depot.m_regions[regionCount].m_end.store(g_depot.m_regionEnd, std::memory_order_relaxed);
+                    g_depot.m_regionCount.store(regionCount + 1, std::memory_order_release);
+                }
+
+                slab = reinterpret_cast<void*>(g_depot.m_regionCursor);
+                g_depot.m_regionCursor += SizeClassAllocator::SlabSize;
+            }
+
+            if(!CommitSlab(slab))
+            {
+                return nullptr;
+            }
+
+            SlabHeader *header = static_cast<SlabHeader*>(slab);
+            header->m_magic = SlabMagic;
+            header->m_sizeClass = static_cast<uint32_t>(sizeClass);
+
+            g_depot.m_slabCount.fetch_add(1, std::memory_order_relaxed);
+
+            return slab;
+        }
+
+        // Moves up to 'count' blocks of the given class from the depot into a singly linked chain.
+        size_t FetchFromDepot(const int sizeClass, const size_t count, FreeBlock *&outHead) noexcept
+        {
+            CentralClass &central = g_depot.m_classes[sizeClass];
+            const size_t blockSize = SizeClasses[sizeClass];
+            FreeBlock *head = nullptr;
+            size_t fetched = 0;
+
+            SpinLockGuard guard(central.m_lock);
+
+            while(fetched < count && central.m_freeList)
+            {
+                FreeBlock *block = central.m_freeList;
+
+                central.m_freeList = block->m_next;
+                --central.m_freeCount;
+
+                block->m_next = head;
+                head = block;
+                ++fetched;
+            }
+
+            while(fetched < count)
+            {
+                if(central.m_bumpPointer + blockSize > central.m_bumpEnd)
+                {
+                    uint8_t *slab = static_cast<uint8_t*>(AllocateSlab(sizeClass));
+
+                    if(!slab)
+                    {
+                        break;
+                    }
+
+                    central.m_bumpPointer = reinterpret_cast<uintptr_t>(slab + SlabHeaderSize);
+                    central.m_bumpEnd = reinterpret_cast<uintptr_t>(slab + SizeClassAllocator::SlabSize);
+                }
+
+                FreeBlock *block = reinterpret_cast<FreeBlock*>(central.m_bumpPointer);
+
+                central.m_bumpPointer += blockSize;
+
+                block->m_next = head;
+                head = block;
+                ++fetched;
+            }
+
+            outHead = head;
+
+            return fetched;
+        }
+
+        void ReturnToDepot(const int sizeClass, FreeBlock *head, FreeBlock *tail, const size_t count) noexcept
+        {
+            CentralClass &central = g_depot.m_classes[sizeClass];
+
+            SpinLockGuard guard(central.m_lock);
+
+            tail->m_next = central.m_freeList;
+            central.m_freeList = head;
+            central.m_freeCount += count;
+        }
+
+        struct ThreadCache
+        {
+            struct ClassCache
+            {
+                FreeBlock *m_head;
+                size_t     m_count;
+            };
+
+            ClassCache m_classes[SizeClassAllocator::SizeClassCount];
+
+            ThreadCache() noexcept
+                : m_classes()
+            {
+            }
+
+            ~ThreadCache()
+            {
+                Flush();
+            }
+
+            void Flush() noexcept
+            {
+                for(int sizeClass = 0; sizeClass < SizeClassAllocator::SizeClassCount; ++sizeClass)
+                {
+                    ClassCache &cache = m_classes[sizeClass];
+
+                    if(cache.m_count > 0)
+                    {
+                        FreeBlock *tail = cache.m_head;
+
+                        while(tail->m_next)
+                        {
+                            tail = tail->m_next;
+                        }
+
+                        ReturnToDepot(sizeClass, cache.m_head, tail, cache.m_count);
+
+                        cache.m_head = nullptr;
+                        cache.m_count = 0;
+                    }
+                }
+            }
+
+            void* Allocate(const int sizeClass) noexcept
+            {
+                ClassCache &cache = m_classes[sizeClass];
+
+                if(!cache.m_head)
+                {
+                    cache.m_count = FetchFromDepot(sizeClass, BatchSize(sizeClass), cache.m_head);
+
+                    if(!cache.m_head)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                FreeBlock *block = cache.m_head;
+
+                cache.m_head = block->m_next;
+                --cache.m_count;
+
+                return block;
+            }
+
+            void Deallocate(void *memory, const int sizeClass) noexcept
+            {
+                ClassCache &cache = m_classes[sizeClass];
+                FreeBlock *block = static_cast<FreeBlock*>(memory);
+
+                block->m_next = cache.m_head;
+                cache.m_head = block;
+                ++cache.m_count;
+
+                const size_t batchSize = BatchSize(sizeClass);
+
+                if(cache.m_count >= batchSize * 2)
+                {
+                    // Hand the oldest half back to the depot so blocks freed by consumer threads flow back to producers.
+                    FreeBlock *keepTail = cache.m_head;
+
+                    for(size_t i = 1; i < batchSize; ++i)
+                    {
+                        keepTail = keepTail->m_next;
+                    }
+
+                    FreeBlock *releaseHead = keepTail->m_next;
+                    FreeBlock *releaseTail = releaseHead;
+                    size_t releaseCount = 1;
+
+                    while(releaseTail->m_next)
+                    {
+                        releaseTail = releaseTail->m_next;
+                        ++releaseCount;
+                    }
+
+                    keepTail->m_next = nullptr;
+                    cache.m_count -= releaseCount;
+
+                    ReturnToDepot(sizeClass, releaseHead, releaseTail, releaseCount);
+                }
+            }
+        };
+
+        ThreadCache& GetThreadCache() noexcept
+        {
+            static thread_local ThreadCache t_cache;
+
+            return t_cache;
+        }
+
+        // Blocks that are not carved from slabs come from the large allocator or the C runtime heap.
+        inline void* HeapAlloc(size_t size) noexcept
+        {
+            return LargeAllocator::IsLarge(size) ? LargeAllocator::Alloc(size) : std::malloc(size);
+        }
+
+        inline void HeapFree(void *memory) noexcept
+        {
+            if(LargeAllocator::Owns(memory))
+            {
+                LargeAllocator::Free(memory);
+            }
+            else
+            {
+                std::free(memory);
+            }
+        }
+
+        size_t GetBlockSize(const void *memory) noexcept
+        {
+            if(SizeClassAllocator::IsSmallBlock(memory))
+            {
+                return SizeClasses[GetSlabHeader(memory)->m_sizeClass];
+            }
+
+            if(LargeAllocator::Owns(memory))
+            {
+                return LargeAllocator::GetSize(memory);
+            }
+
+#ifdef _WIN32
+            return ::_msize(const_cast<void*>(memory));
+#else
+            return ::malloc_usable_size(const_cast<void*>(memory));
+#endif
+        }
+    }
+
+    int SizeClassAllocator::GetSizeClass(size_t size) noexcept
+    {
+        if(size > MaxSmallSize)
+        {
+            return -1;
+        }
+
+        return g_sizeClassLookup.m_classes[(size + 15) >> 4];
+    }
+
+    size_t SizeClassAllocator::GetSizeClassSize(int sizeClass) noexcept
+    {
+        if(sizeClass < 0 || sizeClass >= SizeClassCount)
+        {
+            return 0;
+        }
+
+        return SizeClasses[sizeClass];
+    }
+
+    bool SizeClassAllocator::IsSmallBlock(const void *memory) noexcept
+    {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(memory);
+        const int regionCount = g_depot.m_regionCount.load(std::memory_order_acquire);
+
+        // Newer regions are the busiest, so search backwards.
+        for(int i = regionCount - 1; i >= 0; --i)
+        {
+            const Region &region = g_depot.m_regions[i];
+
+            if(address >= region.m_begin.load(std::memory_order_relaxed) && address < region.m_end.load(std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void* SizeClassAllocator::Alloc(size_t size)
+    {
+        const int sizeClass = GetSizeClass(size);
+
+        if(sizeClass >= 0)
+        {
+            void *memory = GetThreadCache().Allocate(sizeClass);
+
+            if(memory)
+            {
+                return memory;
+            }
+        }
+
+        return HeapAlloc(size);
+    }
+
+    void* SizeClassAllocator::CAlloc(size_t count, size_t size)
+    {
+        if(size != 0 && count > SIZE_MAX / size)
+        {
+            return nullptr;
+        }
+
+        const size_t totalSize = count * size;
+
+        if(LargeAllocator::IsLarge(totalSize))
+        {
+            return LargeAllocator::Alloc(totalSize);
+        }
+
+        if(totalSize > MaxSmallSize)
+        {
+            return std::calloc(count, size);
+        }
+
+        void *memory = Alloc(totalSize);
+
+        if(memory)
+        {
+            std::memset(memory, 0, totalSize);
+        }
+
+        return memory;
+    }
+
+    void* SizeClassAllocator::Realloc(void *memory, size_t size)
+    {
+        if(!memory)
+        {
+            return Alloc(size);
+        }
+
+        if(size == 0)
+        {
+            Free(memory);
+
+            return nullptr;
+        }
+
+        if(LargeAllocator::Owns(memory))
+        {
+            if(size > MaxSmallSize)
+            {
+                return LargeAllocator::Realloc(memory, size);
+            }
+        }
+        else if(!IsSmallBlock(memory))
+        {
+            if(size > MaxSmallSize && !LargeAllocator::IsLarge(size))
+            {
+                return std::realloc(memory, size);
+            }
+        }
+        else if(GetSizeClass(size) == static_cast<int>(GetSlabHeader(memory)->m_sizeClass))
+        {
+            return memory;
+        }
+
+        void *newMemory = Alloc(size);
+
+        if(newMemory)
+        {
+            const size_t oldSize = GetBlockSize(memory);
+
+            std::memcpy(newMemory, memory, oldSize < size ? oldSize : size);
+
+            Free(memory);
+        }
+
+        return newMemory;
+    }
+
+    void SizeClassAllocator::Free(void *memory)
+    {
+        if(!memory)
+        {
+            return;
+        }
+
+        if(IsSmallBlock(memory))
+        {
+            GetThreadCache().Deallocate(memory, static_cast<int>(GetSlabHeader(memory)->m_sizeClass));
+        }
+        else
+        {
+            HeapFree(memory);
+        }
+    }
+
+    void SizeClassAllocator::Free(void *memory, size_t size)
+    {
+        if(!memory)
+        {
+            return;
+        }
+
+        // The size class follows from the size, so the slab header does not have to be read. The region check
+        // is still needed for small blocks that fell back to the heap when no slab could be committed.
+        if(size <= MaxSmallSize && IsSmallBlock(memory))
+        {
+            assert(GetSizeClass(size) == static_cast<int>(GetSlabHeader(memory)->m_sizeClass));
+
+            GetThreadCache().Deallocate(memory, GetSizeClass(size));
+        }
+        else
+        {
+            HeapFree(memory);
+        }
+    }
+
+    void* SizeClassAllocator::AlignedAlloc(size_t size, size_t alignment)
+    {
+        if(alignment == 0 || (alignment & (alignment - 1)) != 0)
+        {
+            return nullptr;
+        }
+
+        if(alignment < MinAlignment)
+        {
+            alignment = MinAlignment;
+        }
+
+        const size_t headerSize = sizeof(AlignedHeader);
+
+        if(size > SIZE_MAX - alignment - headerSize)
+        {
+            return nullptr;
+        }
+
+        void *block = Alloc(size + alignment + headerSize);
+
+        if(!block)
+        {
+            return nullptr;
+        }
+
+        const uintptr_t aligned = (reinterpret_cast<uintptr_t>(block) + headerSize + alignment - 1) & ~(alignment - 1);
+        AlignedHeader *header = reinterpret_cast<AlignedHeader*>(aligned) - 1;
+
+        header->m_block = block;
+        header->m_size = size;
+
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void* SizeClassAllocator::AlignedCAlloc(size_t count, size_t size, size_t alignment)
+    {
+        if(size != 0 && count > SIZE_MAX / size)
+        {
+            return nullptr;
+        }
+
+        void *memory = AlignedAlloc(count * size, alignment);
+
+        if(memory)
+        {
+            std::memset(memory, 0, count * size);
+        }
+
+        return memory;
+    }
+
+    void* SizeClassAllocator::AlignedRealloc(void *memory, size_t size, size_t alignment)
+    {
+        if(!memory)
+        {
+            return AlignedAlloc(size, alignment);
+        }
+
+        if(size == 0)
+        {
+            AlignedFree(memory);
+
+            return nullptr;
+        }
+
+        const AlignedHeader *header = static_cast<AlignedHeader*>(memory) - 1;
+        void *newMemory = AlignedAlloc(size, alignment);
+
+        if(newMemory)
+        {
+            std::memcpy(newMemory, memory, header->m_size < size ? header->m_size : size);
+
+            AlignedFree(memory);
+        }
+
+        return newMemory;
+    }
+
+    void SizeClassAllocator::AlignedFree(void *memory)
+    {
+        if(!memory)
+        {
+            return;
+        }
+
+        Free((static_cast<AlignedHeader*>(memory) - 1)->m_block);
+    }
+
+    void SizeClassAllocator::AlignedFree(void *memory, size_t size, size_t alignment)
+    {
+        if(!memory)
+        {
+            return;
+        }
+
+        if(alignment < MinAlignment)
+        {
+            alignment = MinAlignment;
+        }
+
+        Free((static_cast<AlignedHeader*>(memory) - 1)->m_block, size + alignment + sizeof(AlignedHeader));
+    }
+
+    void SizeClassAllocator::FlushThreadCache() noexcept
+    {
+        GetThreadCache().Flush();
+    }
+
+    SizeClassAllocator::Statistics SizeClassAllocator::GetStatistics() noexcept
+    {
+        Statistics stats;
+
+        stats.m_regionCount = static_cast<size_t>(g_depot.m_regionCount.load(std::memory_order_acquire));
+        stats.m_slabCount = g_depot.m_slabCount.load(std::memory_order_relaxed);
+        stats.m_reservedBytes = stats.m_regionCount * RegionSize;
+        stats.m_committedBytes = stats.m_slabCount * SlabSize;
+
+        return stats;
+    }
+
+    AllocatorHooks SizeClassAllocator::CreateHooks() noexcept
+    {
+        return MakeAllocatorHooks<SizeClassAllocator>();
+    }
+
+    void SizeClassAllocator::Install() noexcept
+    {
+        Memory::SetAllocatorHooks(CreateHooks());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef _DOTNETNATIVE_SIZECLASSALLOCATOR_H_
+#define _DOTNETNATIVE_SIZECLASSALLOCATOR_H_
+
+#include "AllocatorHooks.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DotNetNative
+{
+    // A thread-caching size-class allocator. Small blocks (up to MaxSmallSize bytes) are rounded up to one of
+    // SizeClassCount size classes and carved out of SlabSize slabs that live in large reserved address regions.
+    // Each thread keeps a free list per size class and only touches the shared depot, which is protected by a
+    // per-class spin lock, to move whole batches of blocks. Larger blocks are forwarded to LargeAllocator once they
+    // reach its threshold and to the C runtime heap below it.
+    //
+    // Install it at runtime with SizeClassAllocator::Install(), compile the library with DNN_USE_SIZE_CLASS_ALLOCATOR
+    // to make it the default backend of Memory, or use it as the DNN_ALLOCATOR_POLICY to call it directly.
+    class SizeClassAllocator
+    {
+    public:
+        static constexpr size_t MinAlignment = 16;
+        static constexpr size_t MaxSmallSize = 8192;
+        static constexpr size_t SlabSize = 64 * 1024;
+        static constexpr size_t RegionSize = 64 * 1024 * 1024;
+        static constexpr int    SizeClassCount = 32;
+
+        struct Statistics
+        {
+            size_t m_regionCount;
+            size_t m_slabCount;
+            size_t m_reservedBytes;
+            size_t m_committedBytes;
+        };
+
+    private:
+        SizeClassAllocator() = delete;
+        SizeClassAllocator(const SizeClassAllocator &copy) = delete;
+        SizeClassAllocator(SizeClassAllocator &&mov) = delete;
+        ~SizeClassAllocator() = delete;
+
+    public:
+        static void* Alloc(size_t size);
+        static void* CAlloc(size_t count, size_t size);
+        static void* Realloc(void *memory, size_t size);
+        static void Free(void *memory);
+        static void Free(void *memory, size_t size);
+
+        static void* AlignedAlloc(size_t size, size_t alignment);
+        static void* AlignedCAlloc(size_t count, size_t size, size_t alignment);
+        static void* AlignedRealloc(void *memory, size_t size, size_t alignment);
+        static void AlignedFree(void *memory);
+        static void AlignedFree(void *memory, size_t size, size_t alignment);
+
+        // Returns true if the block was carved from one of the allocator's slabs.
+        static bool IsSmallBlock(const void *memory) noexcept;
+
+        // Returns the size class index used for a request of the given size or -1 if the request is served by the large heap.
+        static int GetSizeClass(size_t size) noexcept;
+        static size_t GetSizeClassSize(int sizeClass) noexcept;
+
+        // Returns every block cached by the calling thread to the shared depot. This happens automatically when a thread exits.
+        static void FlushThreadCache() noexcept;
+
+        static Statistics GetStatistics() noexcept;
+
+        static AllocatorHooks CreateHooks() noexcept;
+        static void Install() noexcept;
+    };
+}
+
+#endif
\ No newline at end of file
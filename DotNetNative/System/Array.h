@@ -49,6 +49,13 @@ namespace DotNetNative
             static void Copy(const T *source, T *destination, const size_t count);
             static void Copy(const Array<T> &source, const size_t sourceIndex, Array<T> &destination, const size_t destinationIndex, const size_t count);
             static void Clear(Array<T> &arr, const size_t index, const size_t count);
+
+            //
+            // Summary:
+            //     Changes the number of elements of an array to the specified new size. Arrays of trivially
+            //     copyable elements are reallocated, so large arrays grow without copying where the allocator
+            //     can remap them; other elements are moved into a new block.
+            static void Resize(Array<T> &arr, const int64_t newSize);
         };
 
         //////////////////////////////////////////////////////// Array ////////////////////////////////////////////////////////
@@ -162,7 +169,7 @@ namespace DotNetNative
                     }
                 }
 
-                DNN_Free(m_array);
+                DNN_SizedFree(m_array, sizeof(T) * m_length);
                 m_array = nullptr;
             }
 
@@ -190,7 +197,7 @@ namespace DotNetNative
                             }
                         }
 
-                        DNN_Free(m_array);
+                        DNN_SizedFree(m_array, sizeof(T) * m_length);
                         m_array = nullptr;
                     }
 
@@ -326,6 +333,85 @@ namespace DotNetNative
             }
         }
 
+        template <typename T>
+        void Array<T>::Resize(Array<T> &arr, const int64_t newSize)
+        {
+            if(newSize < 0)
+            {
+                throw ArgumentOutOfRangeException("newSize");
+            }
+
+            if(newSize == arr.m_length)
+            {
+                return;
+            }
+
+            const int64_t length = arr.m_length;
+            T *array = nullptr;
+
+            if(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value)
+            {
+                if(newSize == 0)
+                {
+                    DNN_SizedFree(arr.m_array, sizeof(T) * length);
+                }
+                else
+                {
+                    array = reinterpret_cast<T*>(DNN_Realloc(arr.m_array, sizeof(T) * newSize));
+
+                    if(!array)
+                    {
+                        throw std::bad_alloc();
+                    }
+                }
+            }
+            else
+            {
+                if(newSize > 0)
+                {
+                    array = reinterpret_cast<T*>(DNN_Alloc(sizeof(T) * newSize));
+
+                    if(!array)
+                    {
+                        throw std::bad_alloc();
+                    }
+
+                    for(int64_t i = 0; i < length && i < newSize; ++i)
+                    {
+                        new (array + i) T(std::move(arr.m_array[i]));
+                    }
+                }
+
+                for(int64_t i = 0; i < length; ++i)
+                {
+                    (arr.m_array + i)->~T();
+                }
+
+                if(arr.m_array)
+                {
+                    DNN_SizedFree(arr.m_array, sizeof(T) * length);
+                }
+            }
+
+            if(newSize > length)
+            {
+                if(std::is_trivially_constructible<T>::value)
+                {
+                    memset(array + length, 0, sizeof(T) * (newSize - length));
+                }
+                else
+                {
+                    for(int64_t i = length; i < newSize; ++i)
+                    {
+                        new (array + i) T();
+                    }
+                }
+            }
+
+            arr.m_array = array;
+            arr.m_length = newSize;
+        }
+
         template <typename T>
         unique_ptr<Collections::IEnumerator<T>> Array<T>::GetEnumerator()
         {
@@ -374,5 +374,25 @@ namespace DotNetNative
             // The 0x40u << 10 below is to account for uuuuu = wwww + 1 in the surrogate encoding.
             return (static_cast<int>(highSurrogateOffset) << 10) + (lowSurrogate - CharUnicodeInfo::LOW_SURROGATE_START) + (0x40 << 10);
         }
+
+        utf16char Char::ToUpperInvariant(const utf16char c) noexcept
+        {
+            if(IsAscii(c))
+            {
+                return IsInRange(c, 'a', 'z') ? static_cast<utf16char>(c - 0x20) : c;
+            }
+
+            return static_cast<utf16char>(CharUnicodeInfo::ToUpper(c));
+        }
+
+        utf16char Char::ToLowerInvariant(const utf16char c) noexcept
+        {
+            if(IsAscii(c))
+            {
+                return IsInRange(c, 'A', 'Z') ? static_cast<utf16char>(c + 0x20) : c;
+            }
+
+            return static_cast<utf16char>(CharUnicodeInfo::ToLower(c));
+        }
     }
 }
\ No newline at end of file
@@ -66,10 +66,12 @@ namespace DotNetNative
             static bool IsSurrogatePair(const utf16char highSurrogate, const utf16char lowSurrogate) noexcept;
             static int ConvertToUtf32(const utf16char highSurrogate, const utf16char lowSurrogate) noexcept;
 
+            // Simple case mappings of the invariant culture, see CharUnicodeInfo::ToUpper.
+            static utf16char ToUpperInvariant(const utf16char c) noexcept;
+            static utf16char ToLowerInvariant(const utf16char c) noexcept;
+
             // ToUpper()
-            // ToUpperInvariant()
             // ToLower()
-            // ToLowerInvariant()
         };
     }
 }
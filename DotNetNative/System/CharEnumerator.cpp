@@ -5,38 +5,25 @@ namespace DotNetNative
 {
     namespace System
     {
-        CharEnumerator::CharEnumerator(const shared_ptr<utf16char[]> &chars, const int length)
-            : m_chars(chars)
-            , m_length(length)
+        CharEnumerator::CharEnumerator(const String &str)
+            : m_string(str)
             , m_index(-1)
             , m_current(0)
         {
-            if(!chars && length > 0)
-            {
-                throw ArgumentNullException();
-            }
-
-            if(length < 0)
-            {
-                throw ArgumentOutOfRangeException();
-            }
         }
 
         CharEnumerator::CharEnumerator(const CharEnumerator &copy)
-            : m_chars(copy.m_chars)
-            , m_length(copy.m_length)
+            : m_string(copy.m_string)
             , m_index(copy.m_index)
             , m_current(copy.m_current)
         {
         }
 
         CharEnumerator::CharEnumerator(CharEnumerator &&mov) noexcept
-            : m_chars(std::move(mov.m_chars))
-            , m_length(mov.m_length)
+            : m_string(std::move(mov.m_string))
             , m_index(mov.m_index)
             , m_current(mov.m_current)
         {
-            mov.m_length = 0;
             mov.m_index = -1;
             mov.m_current = 0;
         }
@@ -45,8 +32,7 @@ namespace DotNetNative
         {
             if(this != &copy)
             {
-                m_chars = copy.m_chars;
-                m_length = copy.m_length;
+                m_string = copy.m_string;
                 m_index = copy.m_index;
                 m_current = copy.m_current;
             }
@@ -58,12 +44,10 @@ namespace DotNetNative
         {
             if(this != &mov)
             {
-                m_chars = std::move(mov.m_chars);
-                m_length = mov.m_length;
+                m_string = std::move(mov.m_string);
                 m_index = mov.m_index;
                 m_current = mov.m_current;
 
-                mov.m_length = 0;
                 mov.m_index = -1;
                 mov.m_current = 0;
             }
@@ -84,7 +68,7 @@ namespace DotNetNative
                 throw new InvalidOperationException("Enumeration not started.");
             }
 
-            if(m_index >= m_length)
+            if(m_index >= m_string.Length())
             {
                 throw new InvalidOperationException("Enumeration has ended.");
             }
@@ -105,7 +89,7 @@ namespace DotNetNative
                 throw new InvalidOperationException("Enumeration not started.");
             }
 
-            if(m_index >= m_length)
+            if(m_index >= m_string.Length())
             {
                 throw new InvalidOperationException("Enumeration has ended.");
             }
@@ -126,15 +110,15 @@ namespace DotNetNative
         //     The collection was modified after the enumerator was created.
         bool CharEnumerator::MoveNext()
         {
-            if(m_index < m_length - 1)
+            if(m_index < m_string.Length() - 1)
             {
                 ++m_index;
-                m_current = m_chars.get()[m_index];
+                m_current = m_string[m_index];
                 return true;
             }
             else
             {
-                m_index = m_length;
+                m_index = m_string.Length();
             }
 
             return false;
@@ -2,26 +2,28 @@
 #define _DOTNETNATIVE_SYSTEM_CHARENUMERATOR_H_
 
 #include "../MemoryUtil.h"
+#include "../ObjectPool.h"
 #include "Object.h"
 #include "Collections/IEnumerator.h"
 #include "Char.h"
+#include "String.h"
 
 namespace DotNetNative
 {
     namespace System
     {
-        class CharEnumerator
+        class CharEnumerator final
             : public Object
             , public Collections::IEnumerator<utf16char>
+            , public PooledObject<CharEnumerator>
         {
         private:
-            shared_ptr<utf16char[]> m_chars;
-            int                     m_length;
-            int                     m_index;
-            utf16char               m_current;
+            String    m_string;
+            int       m_index;
+            utf16char m_current;
 
         public:
-            CharEnumerator(const shared_ptr<utf16char[]> &chars, const int length);
+            CharEnumerator(const String &str);
             CharEnumerator(const CharEnumerator &copy);
             CharEnumerator(CharEnumerator &&mov) noexcept;
             virtual ~CharEnumerator() {}
@@ -19,6 +19,13 @@ namespace DotNetNative
         extern const uint8_t NumericLevel2Index[1024];
         extern const uint8_t NumericLevel3Index[1824];
         extern const uint8_t NumericValues[1320];
+        extern const uint8_t CaseLevel1Index[490];
+        extern const uint8_t CaseLevel2Index[432];
+        extern const uint8_t CaseLevel3Index[1808];
+        extern const int32_t CaseMappingDeltas[354];
+
+        static constexpr int UPPERCASE_OFFSET = 0;
+        static constexpr int LOWERCASE_OFFSET = 1;
 
         /// <summary>
         /// Convert the BMP character or surrogate pointed by index to a UTF32 value.
@@ -121,6 +128,28 @@ namespace DotNetNative
             return -1;
         }
 
+        /// <summary>
+        /// Returns the simple uppercase (offset 0) or lowercase (offset 1) mapping of ch.
+        /// </summary>
+        static int InternalGetCaseMapping(const int ch, const int offset) noexcept
+        {
+            // Get the level 2 item from the highest 9 bits (8 - 16) of ch. Code points past the table have no mapping.
+            int index = ch >> 8;
+
+            if(static_cast<uint32_t>(index) >= static_cast<uint32_t>(std::size(CaseLevel1Index)))
+            {
+                return ch;
+            }
+
+            index = CaseLevel1Index[index];
+
+            // Get the level 2 offset from the 4 - 7 bit of ch.  This provides the base offset of the level 3 table.
+            index = CaseLevel2Index[(index << 4) + ((ch >> 4) & 0x000f)];
+            index = CaseLevel3Index[(index << 4) + (ch & 0x000f)];
+
+            return ch + CaseMappingDeltas[index * 2 + offset];
+        }
+
         UnicodeCategory CharUnicodeInfo::GetUnicodeCategory(const utf16char ch)
         {
             return GetUnicodeCategory(static_cast<int>(ch));
@@ -155,5 +184,15 @@ namespace DotNetNative
 
             return InternalGetNumericValue(InternalConvertToUtf32(str, index));
         }
+
+        int CharUnicodeInfo::ToUpper(const int codePoint) noexcept
+        {
+            return InternalGetCaseMapping(codePoint, UPPERCASE_OFFSET);
+        }
+
+        int CharUnicodeInfo::ToLower(const int codePoint) noexcept
+        {
+            return InternalGetCaseMapping(codePoint, LOWERCASE_OFFSET);
+        }
     }
 }
\ No newline at end of file
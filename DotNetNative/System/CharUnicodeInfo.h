@@ -39,6 +39,11 @@ namespace DotNetNative
 
             static double GetNumericValue(const utf16char ch);
             static double GetNumericValue(const String &str, const int index);
+
+            // The simple (one to one) case mappings of the invariant culture. Code points without one are returned
+            // unchanged, and like .NET the dotless i (U+0131) isn't uppercased and the dotted I (U+0130) isn't lowercased.
+            static int ToUpper(const int codePoint) noexcept;
+            static int ToLower(const int codePoint) noexcept;
         };
     }
 }
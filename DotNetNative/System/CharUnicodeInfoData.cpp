@@ -1566,5 +1566,239 @@ namespace DotNetNative
             0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
             0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
         };
+
+        // 9:4:4 index table of the simple case mapping data.
+        extern const uint8_t CaseLevel1Index[490] =
+        {
+            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x07, 0x06, 0x06, 0x08, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x09, 0x0a, 0x0b, 0x0c,
+            0x06, 0x0d, 0x06, 0x06, 0x0e, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x0f, 0x10, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x11, 0x12, 0x06, 0x06, 0x06, 0x13, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x14,
+            0x06, 0x06, 0x06, 0x06, 0x15, 0x16, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x17, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x18, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x19, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+            0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1a
+        };
+
+        extern const uint8_t CaseLevel2Index[432] =
+        {
+            0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x00, 0x00, 0x00, 0x05, 0x06, 0x07, 0x08, 0x09,
+            0x0a, 0x0a, 0x0a, 0x0b, 0x0c, 0x0a, 0x0a, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x0a, 0x14,
+            0x0a, 0x0a, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x1d, 0x00, 0x00, 0x1e, 0x1f, 0x01, 0x20, 0x03, 0x21, 0x22, 0x0a, 0x23,
+            0x24, 0x06, 0x06, 0x08, 0x08, 0x25, 0x0a, 0x0a, 0x26, 0x0a, 0x0a, 0x0a, 0x27, 0x0a, 0x0a, 0x0a,
+            0x0a, 0x0a, 0x0a, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2e, 0x2e, 0x2f, 0x30, 0x30, 0x31,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x32, 0x32, 0x32, 0x32, 0x32, 0x33,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34, 0x35, 0x35, 0x36, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x37, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x39, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+            0x3a, 0x3b, 0x3a, 0x3a, 0x3b, 0x3c, 0x3a, 0x3d, 0x3a, 0x3a, 0x3a, 0x3e, 0x3f, 0x40, 0x41, 0x42,
+            0x00, 0x00, 0x43, 0x44, 0x45, 0x00, 0x46, 0x47, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x4a, 0x4b, 0x4c, 0x00,
+            0x29, 0x29, 0x29, 0x2c, 0x2c, 0x2c, 0x4d, 0x4e, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x4f, 0x50,
+            0x51, 0x51, 0x52, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x0a, 0x0a, 0x53, 0x00, 0x0a, 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x55, 0x55, 0x0a, 0x0a, 0x0a, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x00, 0x5d,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x5e, 0x00, 0x5f, 0x5f, 0x5f, 0x5f, 0x5f, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x60, 0x60, 0x61, 0x62, 0x62, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x63, 0x62, 0x64,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x65, 0x65, 0x66, 0x67, 0x68, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x69, 0x69, 0x69, 0x6a, 0x6b, 0x6b, 0x6b, 0x6c,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06, 0x08, 0x08, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x06, 0x06, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x6d, 0x6d, 0x6e, 0x6f, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        };
+
+        extern const uint8_t CaseLevel3Index[1808] =
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+            0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+            0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+            0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+            0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+            0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x04,
+            0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x00, 0x00, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x00, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05,
+            0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x00, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x07, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x08,
+            0x09, 0x0a, 0x05, 0x06, 0x05, 0x06, 0x0b, 0x05, 0x06, 0x0c, 0x0c, 0x05, 0x06, 0x00, 0x0d, 0x0e,
+            0x0f, 0x05, 0x06, 0x0c, 0x10, 0x11, 0x12, 0x13, 0x05, 0x06, 0x14, 0x00, 0x12, 0x15, 0x16, 0x17,
+            0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x18, 0x05, 0x06, 0x18, 0x00, 0x00, 0x05, 0x06, 0x18, 0x05,
+            0x06, 0x19, 0x19, 0x05, 0x06, 0x05, 0x06, 0x1a, 0x05, 0x06, 0x00, 0x00, 0x05, 0x06, 0x00, 0x1b,
+            0x00, 0x00, 0x00, 0x00, 0x1c, 0x1d, 0x1e, 0x1c, 0x1d, 0x1e, 0x1c, 0x1d, 0x1e, 0x05, 0x06, 0x05,
+            0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x1f, 0x05, 0x06,
+            0x00, 0x1c, 0x1d, 0x1e, 0x05, 0x06, 0x20, 0x21, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x22, 0x00, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x05, 0x06, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x05, 0x06, 0x24, 0x25, 0x26,
+            0x26, 0x05, 0x06, 0x27, 0x28, 0x29, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x00, 0x2f, 0x2f, 0x00, 0x30, 0x00, 0x31, 0x32, 0x00, 0x00, 0x00,
+            0x2f, 0x33, 0x00, 0x34, 0x00, 0x35, 0x36, 0x00, 0x37, 0x38, 0x36, 0x39, 0x3a, 0x00, 0x00, 0x38,
+            0x00, 0x3b, 0x3c, 0x00, 0x00, 0x3d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e, 0x00, 0x00,
+            0x3f, 0x00, 0x40, 0x3f, 0x00, 0x00, 0x00, 0x41, 0x3f, 0x42, 0x43, 0x43, 0x44, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x47, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x06, 0x05, 0x06, 0x00, 0x00, 0x05, 0x06, 0x00, 0x00, 0x00, 0x16, 0x16, 0x16, 0x00, 0x49,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x4b, 0x4b, 0x4b, 0x00, 0x4c, 0x00, 0x4d, 0x4d,
+            0x01, 0x01, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x4e, 0x4f, 0x4f, 0x4f,
+            0x02, 0x02, 0x50, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x51, 0x52, 0x52, 0x53,
+            0x54, 0x55, 0x00, 0x00, 0x00, 0x56, 0x57, 0x58, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x00, 0x05, 0x06, 0x5f, 0x05, 0x06, 0x00, 0x22, 0x22, 0x22,
+            0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+            0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a,
+            0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x61, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x62,
+            0x00, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+            0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+            0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64,
+            0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64,
+            0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65,
+            0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x00, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x65, 0x00, 0x00,
+            0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+            0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x00, 0x00, 0x66, 0x66, 0x66,
+            0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67, 0x67,
+            0x53, 0x53, 0x53, 0x53, 0x53, 0x53, 0x00, 0x00, 0x58, 0x58, 0x58, 0x58, 0x58, 0x58, 0x00, 0x00,
+            0x68, 0x69, 0x6a, 0x6b, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+            0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x00, 0x00, 0x70, 0x70, 0x70,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x71, 0x00, 0x00, 0x00, 0x72, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x73, 0x00,
+            0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x74, 0x00, 0x00, 0x75, 0x00,
+            0x76, 0x76, 0x76, 0x76, 0x76, 0x76, 0x76, 0x76, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77,
+            0x76, 0x76, 0x76, 0x76, 0x76, 0x76, 0x00, 0x00, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x00, 0x00,
+            0x00, 0x76, 0x00, 0x76, 0x00, 0x76, 0x00, 0x76, 0x00, 0x77, 0x00, 0x77, 0x00, 0x77, 0x00, 0x77,
+            0x78, 0x78, 0x79, 0x79, 0x79, 0x79, 0x7a, 0x7a, 0x7b, 0x7b, 0x7c, 0x7c, 0x7d, 0x7d, 0x00, 0x00,
+            0x76, 0x76, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x77, 0x77, 0x7f, 0x7f, 0x80, 0x00, 0x81, 0x00,
+            0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x82, 0x82, 0x82, 0x82, 0x80, 0x00, 0x00, 0x00,
+            0x76, 0x76, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x77, 0x77, 0x83, 0x83, 0x00, 0x00, 0x00, 0x00,
+            0x76, 0x76, 0x00, 0x00, 0x00, 0x5b, 0x00, 0x00, 0x77, 0x77, 0x84, 0x84, 0x5f, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x85, 0x85, 0x86, 0x86, 0x80, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x87, 0x00, 0x00, 0x00, 0x88, 0x89, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x8a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x00,
+            0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c,
+            0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d, 0x8d,
+            0x00, 0x00, 0x00, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e,
+            0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e, 0x8e,
+            0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f,
+            0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x06, 0x90, 0x91, 0x92, 0x93, 0x94, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x95, 0x96, 0x97,
+            0x98, 0x00, 0x05, 0x06, 0x00, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x99, 0x99,
+            0x05, 0x06, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0x05, 0x06, 0x00,
+            0x00, 0x00, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a,
+            0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x9a, 0x00, 0x9a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9a, 0x00, 0x00,
+            0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x00, 0x00,
+            0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0x05, 0x06, 0x9b, 0x05, 0x06,
+            0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x00, 0x00, 0x00, 0x05, 0x06, 0x9c, 0x00, 0x00,
+            0x05, 0x06, 0x05, 0x06, 0x9d, 0x00, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x9e, 0x9f, 0xa0, 0xa1, 0x9e, 0x00,
+            0xa2, 0xa3, 0xa4, 0xa5, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06, 0x05, 0x06,
+            0x05, 0x06, 0x05, 0x06, 0xa6, 0xa7, 0xa8, 0x05, 0x06, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0xa9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+            0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab,
+            0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xab, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac,
+            0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac,
+            0xab, 0xab, 0xab, 0xab, 0x00, 0x00, 0x00, 0x00, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac,
+            0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0xac, 0x00, 0x00, 0x00, 0x00,
+            0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0xad, 0x00, 0xad, 0xad, 0xad, 0xad,
+            0xad, 0xad, 0xad, 0x00, 0xad, 0xad, 0x00, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae,
+            0xae, 0xae, 0x00, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae,
+            0xae, 0xae, 0x00, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0xae, 0x00, 0xae, 0xae, 0x00, 0x00, 0x00,
+            0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c,
+            0x4c, 0x4c, 0x4c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51, 0x51,
+            0x51, 0x51, 0x51, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf, 0xaf,
+            0xaf, 0xaf, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0,
+            0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0,
+            0xb0, 0xb0, 0xb0, 0xb0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        };
+
+        // Every item contains the uppercase and the lowercase mapping, as differences from the code point.
+        extern const int32_t CaseMappingDeltas[354] =
+        {
+            0, 0, 0, 32, -32, 0, 743, 0,
+            121, 0, 0, 1, -1, 0, 0, -121,
+            -300, 0, 195, 0, 0, 210, 0, 206,
+            0, 205, 0, 79, 0, 202, 0, 203,
+            0, 207, 97, 0, 0, 211, 0, 209,
+            163, 0, 0, 213, 130, 0, 0, 214,
+            0, 218, 0, 217, 0, 219, 56, 0,
+            0, 2, -1, 1, -2, 0, -79, 0,
+            0, -97, 0, -56, 0, -130, 0, 10795,
+            0, -163, 0, 10792, 10815, 0, 0, -195,
+            0, 69, 0, 71, 10783, 0, 10780, 0,
+            10782, 0, -210, 0, -206, 0, -205, 0,
+            -202, 0, -203, 0, 42319, 0, 42315, 0,
+            -207, 0, 42280, 0, 42308, 0, -209, 0,
+            -211, 0, 10743, 0, 42305, 0, 10749, 0,
+            -213, 0, -214, 0, 10727, 0, -218, 0,
+            42307, 0, 42282, 0, -69, 0, -217, 0,
+            -71, 0, -219, 0, 42261, 0, 42258, 0,
+            84, 0, 0, 116, 0, 38, 0, 37,
+            0, 64, 0, 63, -38, 0, -37, 0,
+            -31, 0, -64, 0, -63, 0, 0, 8,
+            -62, 0, -57, 0, -47, 0, -54, 0,
+            -8, 0, -86, 0, -80, 0, 7, 0,
+            -116, 0, 0, -60, -96, 0, 0, -7,
+            0, 80, 0, 15, -15, 0, 0, 48,
+            -48, 0, 0, 7264, 3008, 0, 0, 38864,
+            -6254, 0, -6253, 0, -6244, 0, -6242, 0,
+            -6243, 0, -6236, 0, -6181, 0, 35266, 0,
+            0, -3008, 35332, 0, 3814, 0, 35384, 0,
+            -59, 0, 0, -7615, 8, 0, 0, -8,
+            74, 0, 86, 0, 100, 0, 128, 0,
+            112, 0, 126, 0, 9, 0, 0, -74,
+            0, -9, -7205, 0, 0, -86, 0, -100,
+            0, -112, 0, -128, 0, -126, 0, -7517,
+            0, -8383, 0, -8262, 0, 28, -28, 0,
+            0, 16, -16, 0, 0, 26, -26, 0,
+            0, -10743, 0, -3814, 0, -10727, -10795, 0,
+            -10792, 0, 0, -10780, 0, -10749, 0, -10783,
+            0, -10782, 0, -10815, -7264, 0, 0, -35332,
+            0, -42280, 48, 0, 0, -42308, 0, -42319,
+            0, -42315, 0, -42305, 0, -42258, 0, -42282,
+            0, -42261, 0, 928, 0, -48, 0, -42307,
+            0, -35384, -928, 0, -38864, 0, 0, 40,
+            -40, 0, 0, 39, -39, 0, 0, 34,
+            -34, 0
+        };
     }
 }
\ No newline at end of file
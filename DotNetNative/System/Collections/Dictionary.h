@@ -5,6 +5,7 @@
 #include "../Array.h"
 #include "IEqualityComparer.h"
 #include "../../MemoryUtil.h"
+#include "../../ObjectPool.h"
 #include "../Exception.h"
 #include "HashHelpers.h"
 #include "EqualityComparer.h"
@@ -54,9 +55,10 @@ namespace DotNetNative
                     ThrowOnExisting = 2
                 };
 
-                class KeyValuePairEnumerator
+                class KeyValuePairEnumerator final
                     : public virtual Object
                     , public IEnumerator<KeyValuePair<TKey, TValue>>
+                    , public PooledObject<KeyValuePairEnumerator>
                 {
                 private:
                     const Dictionary<TKey, TValue>  *m_dictionary;
@@ -72,12 +74,13 @@ namespace DotNetNative
                     virtual bool MoveNext() override;
                     virtual void Reset() override;
 
-                    virtual String ToString() override { return String("System.Collections.Dictionary`2.KeyValuePairEnumerator"); }
+                    virtual String ToString() override { return DNN_STRING("System.Collections.Dictionary`2.KeyValuePairEnumerator"); }
                 };
 
-                class KeyEnumerator
+                class KeyEnumerator final
                     : public virtual Object
                     , public IEnumerator<TKey>
+                    , public PooledObject<KeyEnumerator>
                 {
                 private:
                     KeyValuePairEnumerator m_enumerator;
@@ -90,12 +93,13 @@ namespace DotNetNative
                     virtual bool MoveNext() override { return m_enumerator.MoveNext(); }
                     virtual void Reset() override { m_enumerator.Reset(); }
 
-                    virtual String ToString() override { return String("System.Collections.Dictionary`2.KeyEnumerator"); }
+                    virtual String ToString() override { return DNN_STRING("System.Collections.Dictionary`2.KeyEnumerator"); }
                 };
 
-                class ValueEnumerator
+                class ValueEnumerator final
                     : public virtual Object
                     , public IEnumerator<TValue>
+                    , public PooledObject<ValueEnumerator>
                 {
                 private:
                     KeyValuePairEnumerator m_enumerator;
@@ -108,7 +112,7 @@ namespace DotNetNative
                     virtual bool MoveNext() override { return m_enumerator.MoveNext(); }
                     virtual void Reset() override { m_enumerator.Reset(); }
 
-                    virtual String ToString() override { return String("System.Collections.Dictionary`2.ValueEnumerator"); }
+                    virtual String ToString() override { return DNN_STRING("System.Collections.Dictionary`2.ValueEnumerator"); }
                 };
 
                 class KeyCollection
@@ -122,7 +126,7 @@ namespace DotNetNative
                     inline KeyCollection(const Dictionary<TKey, TValue> *dictionary) : m_dictionary(dictionary) {}
                     virtual ~KeyCollection() {}
 
-                    virtual String ToString() override { return String("System.Collections.Dictionary`2.KeyCollection"); }
+                    virtual String ToString() override { return DNN_STRING("System.Collections.Dictionary`2.KeyCollection"); }
                     virtual int64_t Count() const override { return m_dictionary->Count(); }
 
                     virtual unique_ptr<IEnumerator<TKey>> GetEnumerator() override;
@@ -139,7 +143,7 @@ namespace DotNetNative
                     inline ValueCollection(const Dictionary<TKey, TValue> *dictionary) : m_dictionary(dictionary) {}
                     virtual ~ValueCollection() {}
 
-                    virtual String ToString() override { return String("System.Collections.Dictionary`2.ValueCollection"); }
+                    virtual String ToString() override { return DNN_STRING("System.Collections.Dictionary`2.ValueCollection"); }
                     virtual int64_t Count() const override { return m_dictionary->Count(); }
 
                     virtual unique_ptr<IEnumerator<TValue>> GetEnumerator() override;
@@ -243,7 +247,8 @@ namespace DotNetNative
 
             template <typename TKey, typename TValue>
             Dictionary<TKey, TValue>::Dictionary(const int capacity, const shared_ptr<IEqualityComparer<TKey>> &comparer)
-                : m_count(0)
+                : m_comparer(comparer)
+                , m_count(0)
                 , m_freeList(0)
                 , m_freeCount(0)
                 , m_version(0)
@@ -258,7 +263,7 @@ namespace DotNetNative
                     Initialize(capacity);
                 }
 
-                if(!comparer)
+                if(!m_comparer)
                 {
                     m_comparer = DNN_make_shared(GenericEqualityComparer<TKey>);
                 }
@@ -419,12 +424,12 @@ namespace DotNetNative
                 assert(m_entries != nullptr);
                 assert(newSize >= m_entries->Length());
 
+                // The buckets are rebuilt from scratch, the entries are resized in place.
                 unique_ptr<Array<int>> bucketsPtr = DNN_make_unique(Array<int>, newSize);
-                unique_ptr<Array<Entry>> entriesPtr = DNN_make_unique(Array<Entry>, newSize);
 
-                Array<Entry>::Copy(*m_entries, 0, *entriesPtr, 0, m_count);
+                Array<Entry>::Resize(*m_entries, newSize);
 
-                Array<Entry> &entries = *entriesPtr;
+                Array<Entry> &entries = *m_entries;
                 Array<int> &buckets = *bucketsPtr;
 
                 if(forceNewHashCodes) // TODO-NULLABLE: default(T) == null warning (https://github.com/dotnet/roslyn/issues/34757)
@@ -454,7 +459,6 @@ namespace DotNetNative
                 }
 
                 m_buckets = std::move(bucketsPtr);
-                m_entries = std::move(entriesPtr);
             }
 
             template <typename TKey, typename TValue>
@@ -533,7 +537,8 @@ namespace DotNetNative
                     if(m_count == m_entries->Length())
                     {
                         Resize();
-                        bucket = &buckets[hashCode % static_cast<uint32_t>(m_buckets->Length())];
+                        // Resize replaces the bucket array, the entries array is resized in place.
+                        bucket = &(*m_buckets)[hashCode % static_cast<uint32_t>(m_buckets->Length())];
                     }
 
                     index = m_count;
@@ -645,7 +650,8 @@ namespace DotNetNative
                     if(m_count == m_entries->Length())
                     {
                         Resize();
-                        bucket = &buckets[hashCode % static_cast<uint32_t>(m_buckets->Length())];
+                        // Resize replaces the bucket array, the entries array is resized in place.
+                        bucket = &(*m_buckets)[hashCode % static_cast<uint32_t>(m_buckets->Length())];
                     }
 
                     index = m_count;
@@ -2,6 +2,7 @@
 #define _DOTNETNATIVE_SYSTEM_COLLECTIONS_GENERICENUMERATOR_H_
 
 #include "IEnumerator.h"
+#include "../../ObjectPool.h"
 #include "../Exception.h"
 #include "../Object.h"
 
@@ -12,9 +13,10 @@ namespace DotNetNative
         namespace Collections
         {
             template <typename T>
-            class GenericEnumerator
+            class GenericEnumerator final
                 : public Object
                 , public IEnumerator<T>
+                , public PooledObject<GenericEnumerator<T>>
             {
             private:
                 T              *m_elements;
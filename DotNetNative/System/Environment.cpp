@@ -4,6 +4,6 @@ namespace DotNetNative
 {
     namespace System
     {
-        const String Environment::NewLine("\r\n");
+        const String Environment::NewLine(u"\r\n");
     }
 }
\ No newline at end of file
@@ -0,0 +1,305 @@
+#include "InvariantCasing.h"
+#include "../Char.h"
+#include "../CharUnicodeInfo.h"
+#include "../Numerics/BitOperations.h"
+
+#ifdef DNN_SSE2
+#include <immintrin.h>
+#endif
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        namespace Globalization
+        {
+            using Numerics::BitOperations;
+
+            template <bool TToUpper>
+            static inline int MapCodePoint(const int codePoint) noexcept
+            {
+                if(codePoint < 0x80)
+                {
+                    constexpr int first = TToUpper ? 'a' : 'A';
+
+                    return static_cast<uint32_t>(codePoint - first) <= 'z' - 'a' ? codePoint ^ 0x20 : codePoint;
+                }
+
+                return TToUpper ? CharUnicodeInfo::ToUpper(codePoint) : CharUnicodeInfo::ToLower(codePoint);
+            }
+
+            // Reads the character or surrogate pair at index and returns the number of code units it takes.
+            static inline int ReadCodePoint(const utf16char *chars, const int index, const int length, int &codePoint) noexcept
+            {
+                const utf16char c = chars[index];
+
+                if(Char::IsHighSurrogate(c) && index + 1 < length && Char::IsLowSurrogate(chars[index + 1]))
+                {
+                    codePoint = Char::ConvertToUtf32(c, chars[index + 1]);
+
+                    return 2;
+                }
+
+                codePoint = c;
+
+                return 1;
+            }
+
+            static inline void WriteCodePoint(utf16char *destination, const int codePoint, const int count) noexcept
+            {
+                if(count == 2)
+                {
+                    destination[0] = static_cast<utf16char>(((codePoint - CharUnicodeInfo::UNICODE_PLANE01_START) >> 10) + CharUnicodeInfo::HIGH_SURROGATE_START);
+                    destination[1] = static_cast<utf16char>(((codePoint - CharUnicodeInfo::UNICODE_PLANE01_START) & 0x3ff) + CharUnicodeInfo::LOW_SURROGATE_START);
+                }
+                else
+                {
+                    destination[0] = static_cast<utf16char>(codePoint);
+                }
+            }
+
+#ifdef DNN_SSE2
+            // Returns the lanes of a vector that aren't ASCII.
+            static inline uint32_t GetNonAsciiMask(const __m128i chars) noexcept
+            {
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, _mm_set1_epi16(static_cast<short>(0xff80))), _mm_setzero_si128()))) ^ 0xffff;
+            }
+
+            // Returns the lanes holding ASCII letters that the conversion changes. Lanes that aren't ASCII compare as
+            // out of range, as signed or not.
+            template <bool TToUpper>
+            static inline __m128i GetChangedLetters(const __m128i chars) noexcept
+            {
+                const __m128i beforeFirst = _mm_set1_epi16(TToUpper ? 'a' - 1 : 'A' - 1);
+                const __m128i afterLast = _mm_set1_epi16(TToUpper ? 'z' + 1 : 'Z' + 1);
+
+                return _mm_and_si128(_mm_cmpgt_epi16(chars, beforeFirst), _mm_cmplt_epi16(chars, afterLast));
+            }
+#endif
+
+#ifdef DNN_AVX2
+            static inline uint32_t GetNonAsciiMask(const __m256i chars) noexcept
+            {
+                return ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(chars, _mm256_set1_epi16(static_cast<short>(0xff80))), _mm256_setzero_si256())));
+            }
+
+            template <bool TToUpper>
+            static inline __m256i GetChangedLetters(const __m256i chars) noexcept
+            {
+                const __m256i beforeFirst = _mm256_set1_epi16(TToUpper ? 'a' - 1 : 'A' - 1);
+                const __m256i afterLast = _mm256_set1_epi16(TToUpper ? 'z' + 1 : 'Z' + 1);
+
+                return _mm256_and_si256(_mm256_cmpgt_epi16(chars, beforeFirst), _mm256_cmpgt_epi16(afterLast, chars));
+            }
+#endif
+
+            // Returns the index of the first character from index on that is either not ASCII or changed by the
+            // conversion, or length.
+            template <bool TToUpper>
+            static int SkipUnchangedAscii(const utf16char *chars, int index, const int length) noexcept
+            {
+#ifdef DNN_AVX2
+                for(; index + 16 <= length; index += 16)
+                {
+                    const __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars + index));
+                    const uint32_t mask = GetNonAsciiMask(vector) | static_cast<uint32_t>(_mm256_movemask_epi8(GetChangedLetters<TToUpper>(vector)));
+
+                    if(mask != 0)
+                    {
+                        return index + BitOperations::TrailingZeroCount(mask) / 2;
+                    }
+                }
+#endif
+
+#ifdef DNN_SSE2
+                for(; index + 8 <= length; index += 8)
+                {
+                    const __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + index));
+                    const uint32_t mask = GetNonAsciiMask(vector) | static_cast<uint32_t>(_mm_movemask_epi8(GetChangedLetters<TToUpper>(vector)));
+
+                    if(mask != 0)
+                    {
+                        return index + BitOperations::TrailingZeroCount(mask) / 2;
+                    }
+                }
+#endif
+
+                while(index < length && chars[index] < 0x80 && MapCodePoint<TToUpper>(chars[index]) == chars[index])
+                {
+                    ++index;
+                }
+
+                return index;
+            }
+
+            // Converts the ASCII characters from index on and returns the index of the first character that isn't ASCII,
+            // or length. Vectors are written whole: their characters that aren't ASCII are copied as they are, and
+            // overwritten by the caller.
+            template <bool TToUpper>
+            static int ConvertAscii(const utf16char *source, utf16char *destination, int index, const int length) noexcept
+            {
+#ifdef DNN_AVX2
+                for(; index + 16 <= length; index += 16)
+                {
+                    const __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + index));
+                    const __m256i flip = _mm256_and_si256(GetChangedLetters<TToUpper>(vector), _mm256_set1_epi16(0x20));
+                    const uint32_t mask = GetNonAsciiMask(vector);
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + index), _mm256_xor_si256(vector, flip));
+
+                    if(mask != 0)
+                    {
+                        return index + BitOperations::TrailingZeroCount(mask) / 2;
+                    }
+                }
+#endif
+
+#ifdef DNN_SSE2
+                for(; index + 8 <= length; index += 8)
+                {
+                    const __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index));
+                    const __m128i flip = _mm_and_si128(GetChangedLetters<TToUpper>(vector), _mm_set1_epi16(0x20));
+                    const uint32_t mask = GetNonAsciiMask(vector);
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), _mm_xor_si128(vector, flip));
+
+                    if(mask != 0)
+                    {
+                        return index + BitOperations::TrailingZeroCount(mask) / 2;
+                    }
+                }
+#endif
+
+                for(; index < length && source[index] < 0x80; ++index)
+                {
+                    destination[index] = static_cast<utf16char>(MapCodePoint<TToUpper>(source[index]));
+                }
+
+                return index;
+            }
+
+            // Returns the index of the first character from index on where either sequence isn't ASCII or the sequences
+            // differ other than in the case of ASCII letters, or length.
+            static int SkipEqualAsciiIgnoreCase(const utf16char *chars1, const utf16char *chars2, int index, const int length) noexcept
+            {
+#ifdef DNN_AVX2
+                for(; index + 16 <= length; index += 16)
+                {
+                    const __m256i vector1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars1 + index));
+                    const __m256i vector2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars2 + index));
+                    const __m256i upper1 = _mm256_xor_si256(vector1, _mm256_and_si256(GetChangedLetters<true>(vector1), _mm256_set1_epi16(0x20)));
+                    const __m256i upper2 = _mm256_xor_si256(vector2, _mm256_and_si256(GetChangedLetters<true>(vector2), _mm256_set1_epi16(0x20)));
+                    const uint32_t mask = GetNonAsciiMask(_mm256_or_si256(vector1, vector2)) | ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(upper1, upper2)));
+
+                    if(mask != 0)
+                    {
+                        return index + BitOperations::TrailingZeroCount(mask) / 2;
+                    }
+                }
+#endif
+
+#ifdef DNN_SSE2
+                for(; index + 8 <= length; index += 8)
+                {
+                    const __m128i vector1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars1 + index));
+                    const __m128i vector2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars2 + index));
+                    const __m128i upper1 = _mm_xor_si128(vector1, _mm_and_si128(GetChangedLetters<true>(vector1), _mm_set1_epi16(0x20)));
+                    const __m128i upper2 = _mm_xor_si128(vector2, _mm_and_si128(GetChangedLetters<true>(vector2), _mm_set1_epi16(0x20)));
+                    const uint32_t mask = GetNonAsciiMask(_mm_or_si128(vector1, vector2)) | (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(upper1, upper2))) ^ 0xffff);
+
+                    if(mask != 0)
+                    {
+                        return index + BitOperations::TrailingZeroCount(mask) / 2;
+                    }
+                }
+#endif
+
+                while(index < length && (chars1[index] | chars2[index]) < 0x80 && MapCodePoint<true>(chars1[index]) == MapCodePoint<true>(chars2[index]))
+                {
+                    ++index;
+                }
+
+                return index;
+            }
+
+            template <bool TToUpper>
+            static int IndexOfFirstChange(const utf16char *chars, const int length) noexcept
+            {
+                int i = SkipUnchangedAscii<TToUpper>(chars, 0, length);
+
+                while(i < length)
+                {
+                    int codePoint;
+                    const int count = ReadCodePoint(chars, i, length, codePoint);
+
+                    if(MapCodePoint<TToUpper>(codePoint) != codePoint)
+                    {
+                        return i;
+                    }
+
+                    i = SkipUnchangedAscii<TToUpper>(chars, i + count, length);
+                }
+
+                return -1;
+            }
+
+            template <bool TToUpper>
+            static void ChangeCase(const utf16char *source, utf16char *destination, const int length) noexcept
+            {
+                int i = ConvertAscii<TToUpper>(source, destination, 0, length);
+
+                while(i < length)
+                {
+                    int codePoint;
+                    const int count = ReadCodePoint(source, i, length, codePoint);
+
+                    WriteCodePoint(destination + i, MapCodePoint<TToUpper>(codePoint), count);
+                    i = ConvertAscii<TToUpper>(source, destination, i + count, length);
+                }
+            }
+
+            int InvariantCasing::IndexOfFirstCharToUpper(const utf16char *chars, const int length) noexcept
+            {
+                return IndexOfFirstChange<true>(chars, length);
+            }
+
+            int InvariantCasing::IndexOfFirstCharToLower(const utf16char *chars, const int length) noexcept
+            {
+                return IndexOfFirstChange<false>(chars, length);
+            }
+
+            void InvariantCasing::ToUpper(const utf16char *source, utf16char *destination, const int length) noexcept
+            {
+                ChangeCase<true>(source, destination, length);
+            }
+
+            void InvariantCasing::ToLower(const utf16char *source, utf16char *destination, const int length) noexcept
+            {
+                ChangeCase<false>(source, destination, length);
+            }
+
+            bool InvariantCasing::EqualsIgnoreCase(const utf16char *chars1, const utf16char *chars2, const int length) noexcept
+            {
+                int i = SkipEqualAsciiIgnoreCase(chars1, chars2, 0, length);
+
+                while(i < length)
+                {
+                    int codePoint1;
+                    int codePoint2;
+                    const int count = ReadCodePoint(chars1, i, length, codePoint1);
+
+                    // A surrogate pair only maps to a surrogate pair and any other character to a single one.
+                    if(ReadCodePoint(chars2, i, length, codePoint2) != count
+                        || (codePoint1 != codePoint2 && MapCodePoint<true>(codePoint1) != MapCodePoint<true>(codePoint2)))
+                    {
+                        return false;
+                    }
+
+                    i = SkipEqualAsciiIgnoreCase(chars1, chars2, i + count, length);
+                }
+
+                return true;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef _DOTNETNATIVE_SYSTEM_GLOBALIZATION_INVARIANTCASING_H_
+#define _DOTNETNATIVE_SYSTEM_GLOBALIZATION_INVARIANTCASING_H_
+
+#include "../../GlobalDefs.h"
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        namespace Globalization
+        {
+            // Case conversion of UTF-16 text with the invariant culture's simple case mappings. Runs of ASCII are
+            // converted a vector at a time, other characters and surrogate pairs go through CharUnicodeInfo's tables.
+            class InvariantCasing
+            {
+            private:
+                InvariantCasing() = delete;
+                InvariantCasing(const InvariantCasing &copy) = delete;
+                InvariantCasing(InvariantCasing &&mov) = delete;
+                ~InvariantCasing() = delete;
+
+            public:
+                // Return the index of the first character that the conversion changes, or -1.
+                static int IndexOfFirstCharToUpper(const utf16char *chars, const int length) noexcept;
+                static int IndexOfFirstCharToLower(const utf16char *chars, const int length) noexcept;
+
+                // Write the converted characters to destination, which may be source. The conversion never changes
+                // the length: the mappings keep characters in their plane and leave unpaired surrogates alone.
+                static void ToUpper(const utf16char *source, utf16char *destination, const int length) noexcept;
+                static void ToLower(const utf16char *source, utf16char *destination, const int length) noexcept;
+
+                // Return whether ToUpper converts both sequences to the same characters, without converting them.
+                static bool EqualsIgnoreCase(const utf16char *chars1, const utf16char *chars2, const int length) noexcept;
+            };
+        }
+    }
+}
+
+#endif
\ No newline at end of file
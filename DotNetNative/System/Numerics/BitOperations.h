@@ -0,0 +1,55 @@
+#ifndef _DOTNETNATIVE_SYSTEM_NUMERICS_BITOPERATIONS_H_
+#define _DOTNETNATIVE_SYSTEM_NUMERICS_BITOPERATIONS_H_
+
+#include "../../GlobalDefs.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace DotNetNative { namespace System { namespace Numerics {
+
+    class BitOperations
+    {
+    private:
+        BitOperations() = delete;
+        BitOperations(const BitOperations &copy) = delete;
+        BitOperations(BitOperations &&mov) = delete;
+        ~BitOperations() = delete;
+
+    public:
+        /// <summary>
+        /// Counts the number of trailing zero bits in a non-zero <paramref name="value"/>.
+        /// </summary>
+        inline static int TrailingZeroCount(uint32_t value) noexcept
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+
+            _BitScanForward(&index, value);
+
+            return static_cast<int>(index);
+#else
+            return __builtin_ctz(value);
+#endif
+        }
+
+        /// <summary>
+        /// Returns the index of the highest set bit of a non-zero <paramref name="value"/>.
+        /// </summary>
+        inline static int Log2(uint32_t value) noexcept
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+
+            _BitScanReverse(&index, value);
+
+            return static_cast<int>(index);
+#else
+            return 31 - __builtin_clz(value);
+#endif
+        }
+    };
+}}}
+
+#endif
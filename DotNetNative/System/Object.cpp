@@ -12,7 +12,7 @@ namespace DotNetNative
 
         String Object::ToString()
         {
-            return String("System.Object");
+            return DNN_STRING("System.Object");
         }
 
         int Object::GetHashCode() const
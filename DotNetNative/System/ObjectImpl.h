@@ -73,7 +73,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
                     
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const unsigned char *&obj) { return PointerToHashCode(obj); }
@@ -96,7 +96,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const short *&obj) { return PointerToHashCode(obj); }
@@ -119,7 +119,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const unsigned short *&obj) { return PointerToHashCode(obj); }
@@ -142,7 +142,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const int *&obj) { return PointerToHashCode(obj); }
@@ -165,7 +165,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const unsigned int *&obj) { return PointerToHashCode(obj); }
@@ -191,7 +191,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const long long *&obj) { return PointerToHashCode(obj); }
@@ -217,7 +217,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const unsigned long long *&obj) { return PointerToHashCode(obj); }
@@ -245,7 +245,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const float *&obj) { return PointerToHashCode(obj); }
@@ -271,7 +271,7 @@ namespace DotNetNative
                         throw NotImplementedException();
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const double *&obj) { return PointerToHashCode(obj); }
@@ -280,7 +280,7 @@ namespace DotNetNative
             template <>
             struct ObjectHelper<bool>
             {
-                static String ToString(bool &obj) { return obj ? String("True") : String("False"); }
+                static String ToString(bool &obj) { return obj ? DNN_STRING("True") : DNN_STRING("False"); }
                 static int GetHashCode(const bool &obj) { return obj; }
             };
 
@@ -291,10 +291,10 @@ namespace DotNetNative
                 {
                     if(obj)
                     {
-                        return *obj ? String("True") : String("False");
+                        return *obj ? DNN_STRING("True") : DNN_STRING("False");
                     }
 
-                    return String("null");
+                    return DNN_STRING("null");
                 }
 
                 static int GetHashCode(const bool *&obj) { return PointerToHashCode(obj); }
@@ -0,0 +1,1176 @@
+#include "SpanHelpers.h"
+#include "Char.h"
+#include "Numerics/BitOperations.h"
+
+#ifdef DNN_SSE2
+#include <immintrin.h>
+#endif
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        using Numerics::BitOperations;
+
+        // The code unit value of a character of either kind of sequence.
+        static inline utf16char CodeOf(const utf16char c) noexcept
+        {
+            return c;
+        }
+
+        static inline utf16char CodeOf(const char c) noexcept
+        {
+            return static_cast<uint8_t>(c);
+        }
+
+        size_t SpanHelpers::CommonPrefixLength(const utf16char *first, const utf16char *second, size_t length) noexcept
+        {
+            size_t i = 0;
+
+#ifdef DNN_AVX2
+            // Compares four vectors per step while they match, the loops below find the mismatch.
+            for(; i + 64 <= length; i += 64)
+            {
+                const __m256i *a = reinterpret_cast<const __m256i*>(first + i);
+                const __m256i *b = reinterpret_cast<const __m256i*>(second + i);
+                const __m256i equal01 = _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_loadu_si256(a), _mm256_loadu_si256(b)), _mm256_cmpeq_epi16(_mm256_loadu_si256(a + 1), _mm256_loadu_si256(b + 1)));
+                const __m256i equal23 = _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_loadu_si256(a + 2), _mm256_loadu_si256(b + 2)), _mm256_cmpeq_epi16(_mm256_loadu_si256(a + 3), _mm256_loadu_si256(b + 3)));
+
+                if(_mm256_movemask_epi8(_mm256_and_si256(equal01, equal23)) != -1)
+                {
+                    break;
+                }
+            }
+
+            for(; i + 16 <= length; i += 16)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)));
+
+                if(mask != 0)
+                {
+                    return i + BitOperations::TrailingZeroCount(mask) / 2;
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            for(; i + 32 <= length; i += 32)
+            {
+                const __m128i *a = reinterpret_cast<const __m128i*>(first + i);
+                const __m128i *b = reinterpret_cast<const __m128i*>(second + i);
+                const __m128i equal01 = _mm_and_si128(_mm_cmpeq_epi16(_mm_loadu_si128(a), _mm_loadu_si128(b)), _mm_cmpeq_epi16(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1)));
+                const __m128i equal23 = _mm_and_si128(_mm_cmpeq_epi16(_mm_loadu_si128(a + 2), _mm_loadu_si128(b + 2)), _mm_cmpeq_epi16(_mm_loadu_si128(a + 3), _mm_loadu_si128(b + 3)));
+
+                if(_mm_movemask_epi8(_mm_and_si128(equal01, equal23)) != 0xFFFF)
+                {
+                    break;
+                }
+            }
+
+            for(; i + 8 <= length; i += 8)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b))) & 0xFFFF;
+
+                if(mask != 0)
+                {
+                    return i + BitOperations::TrailingZeroCount(mask) / 2;
+                }
+            }
+#endif
+
+            while(i < length && first[i] == second[i])
+            {
+                ++i;
+            }
+
+            return i;
+        }
+
+        size_t SpanHelpers::CommonPrefixLength(const utf16char *first, const char *second, size_t length) noexcept
+        {
+            const uint8_t *bytes = reinterpret_cast<const uint8_t*>(second);
+            size_t i = 0;
+
+#ifdef DNN_AVX2
+            for(; i + 16 <= length; i += 16)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+                const __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)));
+
+                if(mask != 0)
+                {
+                    return i + BitOperations::TrailingZeroCount(mask) / 2;
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            const __m128i zero = _mm_setzero_si128();
+
+            for(; i + 32 <= length; i += 32)
+            {
+                const __m128i *a = reinterpret_cast<const __m128i*>(first + i);
+                const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+                const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i + 16));
+                const __m128i equal01 = _mm_and_si128(_mm_cmpeq_epi16(_mm_loadu_si128(a), _mm_unpacklo_epi8(low, zero)), _mm_cmpeq_epi16(_mm_loadu_si128(a + 1), _mm_unpackhi_epi8(low, zero)));
+                const __m128i equal23 = _mm_and_si128(_mm_cmpeq_epi16(_mm_loadu_si128(a + 2), _mm_unpacklo_epi8(high, zero)), _mm_cmpeq_epi16(_mm_loadu_si128(a + 3), _mm_unpackhi_epi8(high, zero)));
+
+                if(_mm_movemask_epi8(_mm_and_si128(equal01, equal23)) != 0xFFFF)
+                {
+                    break;
+                }
+            }
+
+            for(; i + 8 <= length; i += 8)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+                const __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bytes + i)), zero);
+                const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b))) & 0xFFFF;
+
+                if(mask != 0)
+                {
+                    return i + BitOperations::TrailingZeroCount(mask) / 2;
+                }
+            }
+#endif
+
+            while(i < length && first[i] == bytes[i])
+            {
+                ++i;
+            }
+
+            return i;
+        }
+
+        int SpanHelpers::SequenceCompareTo(const utf16char *first, size_t firstLength, const utf16char *second, size_t secondLength) noexcept
+        {
+            const size_t length = firstLength < secondLength ? firstLength : secondLength;
+            const size_t index = CommonPrefixLength(first, second, length);
+
+            if(index < length)
+            {
+                return static_cast<int>(first[index]) - static_cast<int>(second[index]);
+            }
+
+            return firstLength < secondLength ? -1 : (firstLength > secondLength ? 1 : 0);
+        }
+
+        size_t SpanHelpers::CommonPrefixLength(const char *first, const char *second, size_t length) noexcept
+        {
+            size_t i = 0;
+
+#ifdef DNN_AVX2
+            for(; i + 32 <= length; i += 32)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+
+                if(mask != 0)
+                {
+                    return i + BitOperations::TrailingZeroCount(mask);
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            for(; i + 16 <= length; i += 16)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xFFFF;
+
+                if(mask != 0)
+                {
+                    return i + BitOperations::TrailingZeroCount(mask);
+                }
+            }
+#endif
+
+            while(i < length && first[i] == second[i])
+            {
+                ++i;
+            }
+
+            return i;
+        }
+
+        int SpanHelpers::SequenceCompareTo(const utf16char *first, size_t firstLength, const char *second, size_t secondLength) noexcept
+        {
+            const size_t length = firstLength < secondLength ? firstLength : secondLength;
+            const size_t index = CommonPrefixLength(first, second, length);
+
+            if(index < length)
+            {
+                return static_cast<int>(first[index]) - static_cast<int>(CodeOf(second[index]));
+            }
+
+            return firstLength < secondLength ? -1 : (firstLength > secondLength ? 1 : 0);
+        }
+
+        int SpanHelpers::SequenceCompareTo(const char *first, size_t firstLength, const char *second, size_t secondLength) noexcept
+        {
+            const size_t length = firstLength < secondLength ? firstLength : secondLength;
+            const size_t index = CommonPrefixLength(first, second, length);
+
+            if(index < length)
+            {
+                return static_cast<int>(CodeOf(first[index])) - static_cast<int>(CodeOf(second[index]));
+            }
+
+            return firstLength < secondLength ? -1 : (firstLength > secondLength ? 1 : 0);
+        }
+
+        int SpanHelpers::IndexOf(const utf16char *searchSpace, int length, utf16char value) noexcept
+        {
+            int i = 0;
+
+#ifdef DNN_AVX2
+            const __m256i target256 = _mm256_set1_epi16(static_cast<short>(value));
+
+            for(; i + 16 <= length; i += 16)
+            {
+                const __m256i equal = _mm256_cmpeq_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(searchSpace + i)), target256);
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+
+                if(mask != 0)
+                {
+                    return i + BitOperations::TrailingZeroCount(mask) / 2;
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            const __m128i target = _mm_set1_epi16(static_cast<short>(value));
+
+            // Checks four vectors per step until one of them matches, the loop below finds the match.
+            for(; i + 32 <= length; i += 32)
+            {
+                const __m128i *vectors = reinterpret_cast<const __m128i*>(searchSpace + i);
+                const __m128i equal01 = _mm_or_si128(_mm_cmpeq_epi16(_mm_loadu_si128(vectors), target), _mm_cmpeq_epi16(_mm_loadu_si128(vectors + 1), target));
+                const __m128i equal23 = _mm_or_si128(_mm_cmpeq_epi16(_mm_loadu_si128(vectors + 2), target), _mm_cmpeq_epi16(_mm_loadu_si128(vectors + 3), target));
+
+                if(_mm_movemask_epi8(_mm_or_si128(equal01, equal23)) != 0)
+                {
+                    break;
+                }
+            }
+
+            for(; i + 8 <= length; i += 8)
+            {
+                const __m128i equal = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i)), target);
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+
+                if(mask != 0)
+                {
+                    return i + BitOperations::TrailingZeroCount(mask) / 2;
+                }
+            }
+#endif
+
+            for(; i < length; ++i)
+            {
+                if(searchSpace[i] == value)
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        int SpanHelpers::LastIndexOf(const utf16char *searchSpace, int length, utf16char value) noexcept
+        {
+            int i = length;
+
+#ifdef DNN_AVX2
+            const __m256i target256 = _mm256_set1_epi16(static_cast<short>(value));
+
+            for(; i >= 16; i -= 16)
+            {
+                const __m256i equal = _mm256_cmpeq_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(searchSpace + i - 16)), target256);
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+
+                if(mask != 0)
+                {
+                    return i - 16 + BitOperations::Log2(mask) / 2;
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            const __m128i target = _mm_set1_epi16(static_cast<short>(value));
+
+            for(; i >= 8; i -= 8)
+            {
+                const __m128i equal = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i - 8)), target);
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+
+                if(mask != 0)
+                {
+                    return i - 8 + BitOperations::Log2(mask) / 2;
+                }
+            }
+#endif
+
+            while(--i >= 0)
+            {
+                if(searchSpace[i] == value)
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        int SpanHelpers::IndexOfAny(const utf16char *searchSpace, int length, const utf16char *values, int valuesLength) noexcept
+        {
+            if(valuesLength == 0)
+            {
+                return -1;
+            }
+
+            if(valuesLength == 1)
+            {
+                return IndexOf(searchSpace, length, values[0]);
+            }
+
+            int i = 0;
+
+#ifdef DNN_SSE2
+            // Small sets are compared a vector at a time, one comparison per value.
+            if(valuesLength <= 5)
+            {
+                // Missing values repeat the first one, so that every set takes the same five comparisons.
+                const __m128i value0 = _mm_set1_epi16(static_cast<short>(values[0]));
+                const __m128i value1 = _mm_set1_epi16(static_cast<short>(values[1]));
+                const __m128i value2 = _mm_set1_epi16(static_cast<short>(values[valuesLength > 2 ? 2 : 0]));
+                const __m128i value3 = _mm_set1_epi16(static_cast<short>(values[valuesLength > 3 ? 3 : 0]));
+                const __m128i value4 = _mm_set1_epi16(static_cast<short>(values[valuesLength > 4 ? 4 : 0]));
+
+                for(; i + 8 <= length; i += 8)
+                {
+                    const __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i));
+                    const __m128i equal01 = _mm_or_si128(_mm_cmpeq_epi16(vector, value0), _mm_cmpeq_epi16(vector, value1));
+                    const __m128i equal23 = _mm_or_si128(_mm_cmpeq_epi16(vector, value2), _mm_cmpeq_epi16(vector, value3));
+                    const __m128i equal = _mm_or_si128(_mm_or_si128(equal01, equal23), _mm_cmpeq_epi16(vector, value4));
+                    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+
+                    if(mask != 0)
+                    {
+                        return i + BitOperations::TrailingZeroCount(mask) / 2;
+                    }
+                }
+            }
+#endif
+
+            // Values below 256 are looked up in a bitmap, others are compared one by one.
+            uint32_t bitmap[8] = {};
+            bool hasOtherValues = false;
+
+            for(int j = 0; j < valuesLength; ++j)
+            {
+                if(values[j] < 256)
+                {
+                    bitmap[values[j] >> 5] |= 1u << (values[j] & 31);
+                }
+                else
+                {
+                    hasOtherValues = true;
+                }
+            }
+
+            for(; i < length; ++i)
+            {
+                const utf16char c = searchSpace[i];
+
+                if(c < 256)
+                {
+                    if(bitmap[c >> 5] & (1u << (c & 31)))
+                    {
+                        return i;
+                    }
+                }
+                else if(hasOtherValues)
+                {
+                    for(int j = 0; j < valuesLength; ++j)
+                    {
+                        if(values[j] == c)
+                        {
+                            return i;
+                        }
+                    }
+                }
+            }
+
+            return -1;
+        }
+
+        int SpanHelpers::IndexOf(const char *searchSpace, int length, utf16char value) noexcept
+        {
+            if(value > 0xff)
+            {
+                return -1;
+            }
+
+            const void *match = std::memchr(searchSpace, value, length);
+
+            return match ? static_cast<int>(static_cast<const char*>(match) - searchSpace) : -1;
+        }
+
+        int SpanHelpers::LastIndexOf(const char *searchSpace, int length, utf16char value) noexcept
+        {
+            if(value > 0xff)
+            {
+                return -1;
+            }
+
+            int i = length;
+
+#ifdef DNN_AVX2
+            const __m256i target256 = _mm256_set1_epi8(static_cast<char>(value));
+
+            for(; i >= 32; i -= 32)
+            {
+                const __m256i equal = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(searchSpace + i - 32)), target256);
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+
+                if(mask != 0)
+                {
+                    return i - 32 + BitOperations::Log2(mask);
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            const __m128i target = _mm_set1_epi8(static_cast<char>(value));
+
+            for(; i >= 16; i -= 16)
+            {
+                const __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i - 16)), target);
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+
+                if(mask != 0)
+                {
+                    return i - 16 + BitOperations::Log2(mask);
+                }
+            }
+#endif
+
+            while(--i >= 0)
+            {
+                if(CodeOf(searchSpace[i]) == value)
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        int SpanHelpers::IndexOfAny(const char *searchSpace, int length, const utf16char *values, int valuesLength) noexcept
+        {
+            // Values above U+00FF never match and are left out.
+            char latin1Values[5];
+            int latin1Count = 0;
+            uint32_t bitmap[8] = {};
+
+            for(int j = 0; j < valuesLength; ++j)
+            {
+                if(values[j] <= 0xff)
+                {
+                    if(latin1Count < 5)
+                    {
+                        latin1Values[latin1Count] = static_cast<char>(values[j]);
+                    }
+
+                    bitmap[values[j] >> 5] |= 1u << (values[j] & 31);
+                    ++latin1Count;
+                }
+            }
+
+            if(latin1Count == 0)
+            {
+                return -1;
+            }
+
+            if(latin1Count == 1)
+            {
+                return IndexOf(searchSpace, length, CodeOf(latin1Values[0]));
+            }
+
+            int i = 0;
+
+#ifdef DNN_SSE2
+            if(latin1Count <= 5)
+            {
+                const __m128i value0 = _mm_set1_epi8(latin1Values[0]);
+                const __m128i value1 = _mm_set1_epi8(latin1Values[1]);
+                const __m128i value2 = _mm_set1_epi8(latin1Values[latin1Count > 2 ? 2 : 0]);
+                const __m128i value3 = _mm_set1_epi8(latin1Values[latin1Count > 3 ? 3 : 0]);
+                const __m128i value4 = _mm_set1_epi8(latin1Values[latin1Count > 4 ? 4 : 0]);
+
+                for(; i + 16 <= length; i += 16)
+                {
+                    const __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i));
+                    const __m128i equal01 = _mm_or_si128(_mm_cmpeq_epi8(vector, value0), _mm_cmpeq_epi8(vector, value1));
+                    const __m128i equal23 = _mm_or_si128(_mm_cmpeq_epi8(vector, value2), _mm_cmpeq_epi8(vector, value3));
+                    const __m128i equal = _mm_or_si128(_mm_or_si128(equal01, equal23), _mm_cmpeq_epi8(vector, value4));
+                    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+
+                    if(mask != 0)
+                    {
+                        return i + BitOperations::TrailingZeroCount(mask);
+                    }
+                }
+            }
+#endif
+
+            for(; i < length; ++i)
+            {
+                const utf16char c = CodeOf(searchSpace[i]);
+
+                if(bitmap[c >> 5] & (1u << (c & 31)))
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+#ifdef DNN_SSE2
+        // Returns the lanes holding a space or one of the controls from tab to carriage return. The controls are
+        // tested in one signed comparison by moving them to the bottom of the signed range.
+        static inline __m128i IsAsciiWhiteSpace(const __m128i chars) noexcept
+        {
+            const __m128i controls = _mm_cmplt_epi16(_mm_add_epi16(chars, _mm_set1_epi16(static_cast<short>(0x8000 - '\t'))), _mm_set1_epi16(static_cast<short>(0x8000 + '\r' - '\t' + 1)));
+
+            return _mm_or_si128(controls, _mm_cmpeq_epi16(chars, _mm_set1_epi16(' ')));
+        }
+#endif
+
+#ifdef DNN_AVX2
+        static inline __m256i IsAsciiWhiteSpace(const __m256i chars) noexcept
+        {
+            const __m256i controls = _mm256_cmpgt_epi16(_mm256_set1_epi16(static_cast<short>(0x8000 + '\r' - '\t' + 1)), _mm256_add_epi16(chars, _mm256_set1_epi16(static_cast<short>(0x8000 - '\t'))));
+
+            return _mm256_or_si256(controls, _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(' ')));
+        }
+#endif
+
+        static inline bool IsAsciiWhiteSpace(const utf16char c) noexcept
+        {
+            return c == ' ' || static_cast<uint32_t>(c - '\t') <= '\r' - '\t';
+        }
+
+        static inline bool IsAsciiWhiteSpace(const char c) noexcept
+        {
+            return IsAsciiWhiteSpace(CodeOf(c));
+        }
+
+#ifdef DNN_SSE2
+        // The same for Latin-1 characters, a byte per lane.
+        static inline __m128i IsAsciiWhiteSpaceLatin1(const __m128i chars) noexcept
+        {
+            const __m128i controls = _mm_cmplt_epi8(_mm_add_epi8(chars, _mm_set1_epi8(static_cast<char>(0x80 - '\t'))), _mm_set1_epi8(static_cast<char>(0x80 + '\r' - '\t' + 1)));
+
+            return _mm_or_si128(controls, _mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')));
+        }
+#endif
+
+#ifdef DNN_AVX2
+        static inline __m256i IsAsciiWhiteSpaceLatin1(const __m256i chars) noexcept
+        {
+            const __m256i controls = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + '\r' - '\t' + 1)), _mm256_add_epi8(chars, _mm256_set1_epi8(static_cast<char>(0x80 - '\t'))));
+
+            return _mm256_or_si256(controls, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' ')));
+        }
+#endif
+
+        // Returns the index of the first character from index on that isn't ASCII white space, or length.
+        static int SkipLeadingAsciiWhiteSpace(const utf16char *searchSpace, int index, const int length) noexcept
+        {
+#ifdef DNN_AVX2
+            for(; index + 16 <= length; index += 16)
+            {
+                const __m256i whiteSpace = IsAsciiWhiteSpace(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(searchSpace + index)));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(whiteSpace));
+
+                if(mask != 0)
+                {
+                    return index + BitOperations::TrailingZeroCount(mask) / 2;
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            for(; index + 8 <= length; index += 8)
+            {
+                const __m128i whiteSpace = IsAsciiWhiteSpace(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + index)));
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(whiteSpace)) ^ 0xffff;
+
+                if(mask != 0)
+                {
+                    return index + BitOperations::TrailingZeroCount(mask) / 2;
+                }
+            }
+#endif
+
+            while(index < length && IsAsciiWhiteSpace(searchSpace[index]))
+            {
+                ++index;
+            }
+
+            return index;
+        }
+
+        // Returns the index past the last character before end that isn't ASCII white space, or 0.
+        static int SkipTrailingAsciiWhiteSpace(const utf16char *searchSpace, int end) noexcept
+        {
+#ifdef DNN_AVX2
+            for(; end >= 16; end -= 16)
+            {
+                const __m256i whiteSpace = IsAsciiWhiteSpace(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(searchSpace + end - 16)));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(whiteSpace));
+
+                if(mask != 0)
+                {
+                    return end - 16 + BitOperations::Log2(mask) / 2 + 1;
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            for(; end >= 8; end -= 8)
+            {
+                const __m128i whiteSpace = IsAsciiWhiteSpace(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + end - 8)));
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(whiteSpace)) ^ 0xffff;
+
+                if(mask != 0)
+                {
+                    return end - 8 + BitOperations::Log2(mask) / 2 + 1;
+                }
+            }
+#endif
+
+            while(end > 0 && IsAsciiWhiteSpace(searchSpace[end - 1]))
+            {
+                --end;
+            }
+
+            return end;
+        }
+
+        static int SkipLeadingAsciiWhiteSpace(const char *searchSpace, int index, const int length) noexcept
+        {
+#ifdef DNN_AVX2
+            for(; index + 32 <= length; index += 32)
+            {
+                const __m256i whiteSpace = IsAsciiWhiteSpaceLatin1(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(searchSpace + index)));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(whiteSpace));
+
+                if(mask != 0)
+                {
+                    return index + BitOperations::TrailingZeroCount(mask);
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            for(; index + 16 <= length; index += 16)
+            {
+                const __m128i whiteSpace = IsAsciiWhiteSpaceLatin1(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + index)));
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(whiteSpace)) ^ 0xffff;
+
+                if(mask != 0)
+                {
+                    return index + BitOperations::TrailingZeroCount(mask);
+                }
+            }
+#endif
+
+            while(index < length && IsAsciiWhiteSpace(searchSpace[index]))
+            {
+                ++index;
+            }
+
+            return index;
+        }
+
+        static int SkipTrailingAsciiWhiteSpace(const char *searchSpace, int end) noexcept
+        {
+#ifdef DNN_AVX2
+            for(; end >= 32; end -= 32)
+            {
+                const __m256i whiteSpace = IsAsciiWhiteSpaceLatin1(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(searchSpace + end - 32)));
+                const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(whiteSpace));
+
+                if(mask != 0)
+                {
+                    return end - 32 + BitOperations::Log2(mask) + 1;
+                }
+            }
+#endif
+
+#ifdef DNN_SSE2
+            for(; end >= 16; end -= 16)
+            {
+                const __m128i whiteSpace = IsAsciiWhiteSpaceLatin1(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + end - 16)));
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(whiteSpace)) ^ 0xffff;
+
+                if(mask != 0)
+                {
+                    return end - 16 + BitOperations::Log2(mask) + 1;
+                }
+            }
+#endif
+
+            while(end > 0 && IsAsciiWhiteSpace(searchSpace[end - 1]))
+            {
+                --end;
+            }
+
+            return end;
+        }
+
+        template <typename TChar>
+        static int CountLeadingWhiteSpaceOf(const TChar *searchSpace, int length) noexcept
+        {
+            int i = SkipLeadingAsciiWhiteSpace(searchSpace, 0, length);
+
+            // ASCII characters that stop the scan aren't white space, others may be.
+            while(i < length && CodeOf(searchSpace[i]) >= 0x80 && Char::IsWhiteSpace(CodeOf(searchSpace[i])))
+            {
+                i = SkipLeadingAsciiWhiteSpace(searchSpace, i + 1, length);
+            }
+
+            return i;
+        }
+
+        template <typename TChar>
+        static int CountTrailingWhiteSpaceOf(const TChar *searchSpace, int length) noexcept
+        {
+            int end = SkipTrailingAsciiWhiteSpace(searchSpace, length);
+
+            while(end > 0 && CodeOf(searchSpace[end - 1]) >= 0x80 && Char::IsWhiteSpace(CodeOf(searchSpace[end - 1])))
+            {
+                end = SkipTrailingAsciiWhiteSpace(searchSpace, end - 1);
+            }
+
+            return length - end;
+        }
+
+        int SpanHelpers::CountLeadingWhiteSpace(const utf16char *searchSpace, int length) noexcept
+        {
+            return CountLeadingWhiteSpaceOf(searchSpace, length);
+        }
+
+        int SpanHelpers::CountTrailingWhiteSpace(const utf16char *searchSpace, int length) noexcept
+        {
+            return CountTrailingWhiteSpaceOf(searchSpace, length);
+        }
+
+        int SpanHelpers::CountLeadingWhiteSpace(const char *searchSpace, int length) noexcept
+        {
+            return CountLeadingWhiteSpaceOf(searchSpace, length);
+        }
+
+        int SpanHelpers::CountTrailingWhiteSpace(const char *searchSpace, int length) noexcept
+        {
+            return CountTrailingWhiteSpaceOf(searchSpace, length);
+        }
+
+        template <typename THaystack, typename TValue>
+        int SpanHelpers::IndexOfSequence(const THaystack *searchSpace, int length, const TValue *value, int valueLength) noexcept
+        {
+            if(valueLength == 0)
+            {
+                return 0;
+            }
+
+            if(valueLength > length)
+            {
+                return -1;
+            }
+
+            const utf16char first = CodeOf(value[0]);
+            const utf16char last = CodeOf(value[valueLength - 1]);
+
+            if(valueLength == 1)
+            {
+                return IndexOf(searchSpace, length, first);
+            }
+
+            // A Latin-1 sequence can't hold other characters.
+            if(sizeof(THaystack) == 1 && (first > 0xff || last > 0xff))
+            {
+                return -1;
+            }
+
+            const int candidates = length - valueLength + 1;
+            const int middleLength = valueLength - 2;
+
+            // Characters compared while verifying candidates, allowed to grow with the number of positions scanned.
+            size_t budget = 256;
+            int i = 0;
+
+            // Returns the index of value when it is at index, -1 when it isn't, or the result of the Two-Way search
+            // of the rest when verifying candidates costs too much.
+            auto verify = [&](const int index, bool &done) noexcept -> int
+            {
+                const size_t prefix = CommonPrefixLength(searchSpace + index + 1, value + 1, middleLength);
+
+                done = true;
+
+                if(prefix == static_cast<size_t>(middleLength))
+                {
+                    return index;
+                }
+
+                if(budget <= prefix)
+                {
+                    const int result = TwoWayIndexOf(searchSpace + index + 1, length - index - 1, value, valueLength);
+
+                    return result < 0 ? -1 : result + index + 1;
+                }
+
+                done = false;
+                budget -= prefix + 1;
+
+                return -1;
+            };
+
+#ifdef DNN_SSE2
+            if constexpr(sizeof(THaystack) == sizeof(utf16char))
+            {
+                const __m128i firstVector = _mm_set1_epi16(static_cast<short>(first));
+                const __m128i lastVector = _mm_set1_epi16(static_cast<short>(last));
+
+                for(; i + 8 <= candidates; i += 8)
+                {
+                    const __m128i firstEqual = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i)), firstVector);
+                    const __m128i lastEqual = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i + valueLength - 1)), lastVector);
+                    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(firstEqual, lastEqual)));
+
+                    while(mask != 0)
+                    {
+                        const int bit = BitOperations::TrailingZeroCount(mask);
+                        bool done;
+                        const int result = verify(i + bit / 2, done);
+
+                        if(done)
+                        {
+                            return result;
+                        }
+
+                        mask &= ~(3u << bit);
+                    }
+
+                    budget += 8;
+                }
+            }
+            else
+            {
+                const __m128i firstVector = _mm_set1_epi8(static_cast<char>(first));
+                const __m128i lastVector = _mm_set1_epi8(static_cast<char>(last));
+
+                for(; i + 16 <= candidates; i += 16)
+                {
+                    const __m128i firstEqual = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i)), firstVector);
+                    const __m128i lastEqual = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(searchSpace + i + valueLength - 1)), lastVector);
+                    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(firstEqual, lastEqual)));
+
+                    while(mask != 0)
+                    {
+                        const int bit = BitOperations::TrailingZeroCount(mask);
+                        bool done;
+                        const int result = verify(i + bit, done);
+
+                        if(done)
+                        {
+                            return result;
+                        }
+
+                        mask &= mask - 1;
+                    }
+
+                    budget += 16;
+                }
+            }
+#endif
+
+            for(; i < candidates; ++i)
+            {
+                if(CodeOf(searchSpace[i]) == first && CodeOf(searchSpace[i + valueLength - 1]) == last)
+                {
+                    bool done;
+                    const int result = verify(i, done);
+
+                    if(done)
+                    {
+                        return result;
+                    }
+                }
+
+                ++budget;
+            }
+
+            return -1;
+        }
+
+        int SpanHelpers::IndexOf(const utf16char *searchSpace, int length, const utf16char *value, int valueLength) noexcept
+        {
+            return IndexOfSequence(searchSpace, length, value, valueLength);
+        }
+
+        int SpanHelpers::IndexOf(const utf16char *searchSpace, int length, const char *value, int valueLength) noexcept
+        {
+            return IndexOfSequence(searchSpace, length, value, valueLength);
+        }
+
+        int SpanHelpers::IndexOf(const char *searchSpace, int length, const utf16char *value, int valueLength) noexcept
+        {
+            return IndexOfSequence(searchSpace, length, value, valueLength);
+        }
+
+        int SpanHelpers::IndexOf(const char *searchSpace, int length, const char *value, int valueLength) noexcept
+        {
+            return IndexOfSequence(searchSpace, length, value, valueLength);
+        }
+
+        // Crochemore and Perrin's Two-Way string matching: the needle is split at a critical factorization, the right
+        // part is matched left to right and the left part right to left, and shifts use the needle's period. Runs in
+        // O(length + valueLength) time and constant space.
+        template <typename THaystack, typename TValue>
+        int SpanHelpers::TwoWayIndexOf(const THaystack *searchSpace, int length, const TValue *value, int valueLength) noexcept
+        {
+            // Maximal suffix for the < ordering.
+            int suffix = -1;
+            int j = 0;
+            int k = 1;
+            int period = 1;
+
+            while(j + k < valueLength)
+            {
+                const utf16char a = CodeOf(value[suffix + k]);
+                const utf16char b = CodeOf(value[j + k]);
+
+                if(a == b)
+                {
+                    if(k == period)
+                    {
+                        j += period;
+                        k = 1;
+                    }
+                    else
+                    {
+                        ++k;
+                    }
+                }
+                else if(a > b)
+                {
+                    j += k;
+                    k = 1;
+                    period = j - suffix;
+                }
+                else
+                {
+                    suffix = j++;
+                    k = period = 1;
+                }
+            }
+
+            const int firstSuffix = suffix;
+            const int firstPeriod = period;
+
+            // Maximal suffix for the > ordering, the later of the two is the critical position.
+            suffix = -1;
+            j = 0;
+            k = 1;
+            period = 1;
+
+            while(j + k < valueLength)
+            {
+                const utf16char a = CodeOf(value[suffix + k]);
+                const utf16char b = CodeOf(value[j + k]);
+
+                if(a == b)
+                {
+                    if(k == period)
+                    {
+                        j += period;
+                        k = 1;
+                    }
+                    else
+                    {
+                        ++k;
+                    }
+                }
+                else if(a < b)
+                {
+                    j += k;
+                    k = 1;
+                    period = j - suffix;
+                }
+                else
+                {
+                    suffix = j++;
+                    k = period = 1;
+                }
+            }
+
+            if(suffix <= firstSuffix)
+            {
+                suffix = firstSuffix;
+                period = firstPeriod;
+            }
+
+            // For a periodic needle, the prefix matched before a shift by the period is remembered.
+            int memoryOnShift;
+
+            if(SequenceEqual(value, value + period, suffix + 1))
+            {
+                memoryOnShift = valueLength - period;
+            }
+            else
+            {
+                memoryOnShift = 0;
+                period = (suffix > valueLength - suffix - 1 ? suffix : valueLength - suffix - 1) + 1;
+            }
+
+            int memory = 0;
+            int position = 0;
+
+            while(length - position >= valueLength)
+            {
+                const THaystack *window = searchSpace + position;
+
+                // Right part.
+                k = suffix + 1 > memory ? suffix + 1 : memory;
+
+                while(k < valueLength && CodeOf(value[k]) == CodeOf(window[k]))
+                {
+                    ++k;
+                }
+
+                if(k < valueLength)
+                {
+                    position += k - suffix;
+                    memory = 0;
+                    continue;
+                }
+
+                // Left part.
+                k = suffix + 1;
+
+                while(k > memory && CodeOf(value[k - 1]) == CodeOf(window[k - 1]))
+                {
+                    --k;
+                }
+
+                if(k <= memory)
+                {
+                    return position;
+                }
+
+                position += period;
+                memory = memoryOnShift;
+            }
+
+            return -1;
+        }
+
+        template <typename THaystack, typename TValue>
+        int SpanHelpers::LastIndexOfSequence(const THaystack *searchSpace, int length, const TValue *value, int valueLength) noexcept
+        {
+            if(valueLength == 0)
+            {
+                return length;
+            }
+
+            // Each occurrence of the first character that leaves room for value is a candidate, from the last one back.
+            for(int end = length - valueLength + 1; end > 0; )
+            {
+                const int index = LastIndexOf(searchSpace, end, CodeOf(value[0]));
+
+                if(index < 0)
+                {
+                    return -1;
+                }
+
+                if(SequenceEqual(searchSpace + index + 1, value + 1, valueLength - 1))
+                {
+                    return index;
+                }
+
+                end = index;
+            }
+
+            return -1;
+        }
+
+        int SpanHelpers::LastIndexOf(const utf16char *searchSpace, int length, const utf16char *value, int valueLength) noexcept
+        {
+            return LastIndexOfSequence(searchSpace, length, value, valueLength);
+        }
+
+        int SpanHelpers::LastIndexOf(const utf16char *searchSpace, int length, const char *value, int valueLength) noexcept
+        {
+            return LastIndexOfSequence(searchSpace, length, value, valueLength);
+        }
+
+        int SpanHelpers::LastIndexOf(const char *searchSpace, int length, const utf16char *value, int valueLength) noexcept
+        {
+            return LastIndexOfSequence(searchSpace, length, value, valueLength);
+        }
+
+        int SpanHelpers::LastIndexOf(const char *searchSpace, int length, const char *value, int valueLength) noexcept
+        {
+            return LastIndexOfSequence(searchSpace, length, value, valueLength);
+        }
+
+        size_t SpanHelpers::IndexOfNullCharacter(const utf16char *str) noexcept
+        {
+#ifdef DNN_SSE2
+            const uintptr_t address = reinterpret_cast<uintptr_t>(str);
+
+            // Aligned loads never cross into the next page, so reading the rest of the block that holds the
+            // terminator is safe. Characters before str in the first block are masked out.
+            if((address & 1) == 0)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i *block = reinterpret_cast<const __m128i*>(address & ~static_cast<uintptr_t>(15));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(block), zero)));
+
+                mask &= ~0u << (address & 15);
+
+                while(mask == 0)
+                {
+                    ++block;
+                    mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(block), zero)));
+                }
+
+                const uintptr_t terminator = reinterpret_cast<uintptr_t>(block) + BitOperations::TrailingZeroCount(mask);
+
+                return (terminator - address) / sizeof(utf16char);
+            }
+#endif
+
+            size_t length = 0;
+
+            while(str[length])
+            {
+                ++length;
+            }
+
+            return length;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef _DOTNETNATIVE_SYSTEM_SPANHELPERS_H_
+#define _DOTNETNATIVE_SYSTEM_SPANHELPERS_H_
+
+#include "../GlobalDefs.h"
+
+#include <cstddef>
+#include <cstring>
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        // Vectorized searching and comparison of character sequences. Sequences of char are read as Latin-1.
+        class SpanHelpers
+        {
+        private:
+            SpanHelpers() = delete;
+            SpanHelpers(const SpanHelpers &copy) = delete;
+            SpanHelpers(SpanHelpers &&mov) = delete;
+            ~SpanHelpers() = delete;
+
+            // The substring searches for either kind of sequence.
+            template <typename THaystack, typename TValue>
+            static int IndexOfSequence(const THaystack *searchSpace, int length, const TValue *value, int valueLength) noexcept;
+            template <typename THaystack, typename TValue>
+            static int TwoWayIndexOf(const THaystack *searchSpace, int length, const TValue *value, int valueLength) noexcept;
+            template <typename THaystack, typename TValue>
+            static int LastIndexOfSequence(const THaystack *searchSpace, int length, const TValue *value, int valueLength) noexcept;
+
+        public:
+            // Returns the number of leading characters, up to length, that are the same in both sequences.
+            static size_t CommonPrefixLength(const utf16char *first, const utf16char *second, size_t length) noexcept;
+            static size_t CommonPrefixLength(const utf16char *first, const char *second, size_t length) noexcept;
+            static size_t CommonPrefixLength(const char *first, const char *second, size_t length) noexcept;
+            inline static size_t CommonPrefixLength(const char *first, const utf16char *second, size_t length) noexcept
+            {
+                return CommonPrefixLength(second, first, length);
+            }
+
+            // Returns a negative value, zero or a positive value when first orders before, with or after second by
+            // code unit value.
+            static int SequenceCompareTo(const utf16char *first, size_t firstLength, const utf16char *second, size_t secondLength) noexcept;
+            static int SequenceCompareTo(const utf16char *first, size_t firstLength, const char *second, size_t secondLength) noexcept;
+            static int SequenceCompareTo(const char *first, size_t firstLength, const char *second, size_t secondLength) noexcept;
+            inline static int SequenceCompareTo(const char *first, size_t firstLength, const utf16char *second, size_t secondLength) noexcept
+            {
+                return -SequenceCompareTo(second, secondLength, first, firstLength);
+            }
+
+            // Returns the length of a null-terminated string.
+            static size_t IndexOfNullCharacter(const utf16char *str) noexcept;
+
+            // The searches return the index of the first (or last) match, or -1 when there is none.
+            static int IndexOf(const utf16char *searchSpace, int length, utf16char value) noexcept;
+            static int LastIndexOf(const utf16char *searchSpace, int length, utf16char value) noexcept;
+            static int IndexOfAny(const utf16char *searchSpace, int length, const utf16char *values, int valuesLength) noexcept;
+            static int IndexOf(const char *searchSpace, int length, utf16char value) noexcept;
+            static int LastIndexOf(const char *searchSpace, int length, utf16char value) noexcept;
+            static int IndexOfAny(const char *searchSpace, int length, const utf16char *values, int valuesLength) noexcept;
+
+            // Return the number of leading (or trailing) characters that are white space by Char::IsWhiteSpace. ASCII
+            // white space is skipped a vector at a time, only other characters are looked up.
+            static int CountLeadingWhiteSpace(const utf16char *searchSpace, int length) noexcept;
+            static int CountTrailingWhiteSpace(const utf16char *searchSpace, int length) noexcept;
+            static int CountLeadingWhiteSpace(const char *searchSpace, int length) noexcept;
+            static int CountTrailingWhiteSpace(const char *searchSpace, int length) noexcept;
+
+            // Finds candidates by comparing the first and last characters of value a vector of positions at a time. When
+            // verifying candidates costs more than the text scanned, the rest is searched with the Two-Way algorithm,
+            // which stays linear however the needle repeats itself.
+            static int IndexOf(const utf16char *searchSpace, int length, const utf16char *value, int valueLength) noexcept;
+            static int IndexOf(const utf16char *searchSpace, int length, const char *value, int valueLength) noexcept;
+            static int IndexOf(const char *searchSpace, int length, const utf16char *value, int valueLength) noexcept;
+            static int IndexOf(const char *searchSpace, int length, const char *value, int valueLength) noexcept;
+            static int LastIndexOf(const utf16char *searchSpace, int length, const utf16char *value, int valueLength) noexcept;
+            static int LastIndexOf(const utf16char *searchSpace, int length, const char *value, int valueLength) noexcept;
+            static int LastIndexOf(const char *searchSpace, int length, const utf16char *value, int valueLength) noexcept;
+            static int LastIndexOf(const char *searchSpace, int length, const char *value, int valueLength) noexcept;
+
+            // The CRT's memcmp picks the widest vectors the CPU supports at run time.
+            inline static bool SequenceEqual(const utf16char *first, const utf16char *second, size_t length) noexcept
+            {
+                return std::memcmp(first, second, sizeof(utf16char) * length) == 0;
+            }
+
+            inline static bool SequenceEqual(const utf16char *first, const char *second, size_t length) noexcept
+            {
+                return CommonPrefixLength(first, second, length) == length;
+            }
+
+            inline static bool SequenceEqual(const char *first, const utf16char *second, size_t length) noexcept
+            {
+                return CommonPrefixLength(second, first, length) == length;
+            }
+
+            inline static bool SequenceEqual(const char *first, const char *second, size_t length) noexcept
+            {
+                return std::memcmp(first, second, length) == 0;
+            }
+        };
+    }
+}
+
+#endif
\ No newline at end of file
@@ -1,26 +1,294 @@
 #include "String.h"
 #include "Exception.h"
 #include "CharEnumerator.h"
+#include "SpanHelpers.h"
+#include "StringSegment.h"
+#include "StringSplitEnumerator.h"
+#include "Globalization/InvariantCasing.h"
+#include "Text/Latin1Utility.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+
+#define XXH_STATIC_LINKING_ONLY
+#include "../xxhash.h"
 
 namespace DotNetNative
 {
     namespace System
     {
         String::String() noexcept
-            : m_length(0)
+            : m_inline{}
+            , m_length(0)
+        {
+        }
+
+        String::~String()
+        {
+            if(!IsInline())
+            {
+                Release(m_buffer);
+            }
+        }
+
+        String String::FastAllocateString(const int length)
+        {
+            String str;
+
+            str.m_length = length;
+            str.InitializeStorage()[length] = 0;
+
+            return str;
+        }
+
+        String String::FastAllocateLatin1String(const int length)
+        {
+            String str;
+
+            str.m_length = length;
+            str.InitializeLatin1Storage();
+
+            return str;
+        }
+
+        String::Buffer* String::AllocateBuffer(const int length)
+        {
+            void *memory = DNN_Alloc(GetBufferSize(length));
+
+            if(!memory)
+            {
+                throw std::bad_alloc();
+            }
+
+            return InitializeBuffer(memory, length);
+        }
+
+        String::Buffer* String::InitializeBuffer(void *memory, const int length) noexcept
+        {
+            Buffer *buffer = static_cast<Buffer*>(memory);
+
+            new (&buffer->m_refCount) decltype(buffer->m_refCount)(1);
+            new (&buffer->m_hashCode) decltype(buffer->m_hashCode)(0);
+            buffer->m_length = length;
+            buffer->m_flags = 0;
+
+            return buffer;
+        }
+
+        String::Buffer* String::InitializeLatin1Buffer(void *memory, const int length) noexcept
+        {
+            Latin1Buffer *buffer = static_cast<Latin1Buffer*>(InitializeBuffer(memory, length));
+
+            new (&buffer->m_wideChars) decltype(buffer->m_wideChars)(nullptr);
+            buffer->m_flags = Buffer::Latin1Flag;
+
+            return buffer;
+        }
+
+        void String::AddRef(Buffer *buffer) noexcept
+        {
+            if(buffer->m_flags & Buffer::StaticFlag)
+            {
+                return;
+            }
+
+#ifdef DNN_SINGLE_THREADED_STRINGS
+            ++buffer->m_refCount;
+#else
+            buffer->m_refCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+        }
+
+        void String::Release(Buffer *buffer) noexcept
+        {
+            if(buffer->m_flags & Buffer::StaticFlag)
+            {
+                return;
+            }
+
+#ifdef DNN_SINGLE_THREADED_STRINGS
+            if(--buffer->m_refCount == 0)
+#else
+            if(buffer->m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+#endif
+            {
+                if(buffer->m_flags & Buffer::Latin1Flag)
+                {
+                    // The widened characters come from the default backend, see GetWideChars.
+                    if(utf16char *wideChars = static_cast<Latin1Buffer*>(buffer)->m_wideChars)
+                    {
+                        const AllocatorHooks &hooks = Memory::GetDefaultAllocatorHooks();
+
+                        hooks.m_sizedFree(hooks.m_context, wideChars, GetBufferSize(buffer->m_length) - sizeof(Buffer));
+                    }
+
+                    DNN_SizedFree(buffer, GetLatin1BufferSize(buffer->m_length));
+                }
+                else
+                {
+                    DNN_SizedFree(buffer, GetBufferSize(buffer->m_length));
+                }
+            }
+        }
+
+        const utf16char* String::GetWideChars() const
+        {
+            Latin1Buffer *buffer = static_cast<Latin1Buffer*>(m_buffer);
+            utf16char *wideChars = buffer->m_wideChars;
+
+            if(wideChars)
+            {
+                return wideChars;
+            }
+
+            // Copies of the string on other threads may widen it at the same time; the first copy stored is kept.
+            // The copy lives as long as the buffer, which may outlive the current arena or allocator scope.
+            const AllocatorHooks &hooks = Memory::GetDefaultAllocatorHooks();
+            const size_t size = GetBufferSize(m_length) - sizeof(Buffer);
+            utf16char *chars = static_cast<utf16char*>(hooks.m_alloc(hooks.m_context, size));
+
+            if(!chars)
+            {
+                throw std::bad_alloc();
+            }
+
+            Text::Latin1Utility::WidenLatin1ToUtf16(buffer->Latin1Chars(), chars, m_length);
+            chars[m_length] = 0;
+
+#ifdef DNN_SINGLE_THREADED_STRINGS
+            buffer->m_wideChars = chars;
+#else
+            if(!buffer->m_wideChars.compare_exchange_strong(wideChars, chars, std::memory_order_acq_rel))
+            {
+                hooks.m_sizedFree(hooks.m_context, chars, size);
+
+                return wideChars;
+            }
+#endif
+
+            return chars;
+        }
+
+        void String::CopyTo(utf16char *destination) const noexcept
+        {
+            if(IsLatin1())
+            {
+                Text::Latin1Utility::WidenLatin1ToUtf16(GetLatin1Chars(), destination, m_length);
+            }
+            else
+            {
+                memcpy(destination, GetUtf16Chars(), sizeof(utf16char) * m_length);
+            }
+        }
+
+        int String::ComputeHashCode(const utf16char *chars, const int length) noexcept
+        {
+            const size_t size = sizeof(utf16char) * length;
+
+            if(sizeof(void*) >= 8)
+            {
+                const XXH64_hash_t hash = XXH64(chars, size, 0);
+
+                return static_cast<int>(hash ^ (hash >> 32));
+            }
+
+            return static_cast<int>(XXH32(chars, size, 0));
+        }
+
+        int String::ComputeHashCode(const char *chars, const int length) noexcept
+        {
+            // Widened on the stack, a chunk at a time for long strings, so that the hash is the one of the UTF-16
+            // characters.
+            constexpr int ChunkLength = 256;
+            utf16char wide[ChunkLength];
+
+            if(length <= ChunkLength)
+            {
+                Text::Latin1Utility::WidenLatin1ToUtf16(chars, wide, length);
+
+                return ComputeHashCode(wide, length);
+            }
+
+            if(sizeof(void*) >= 8)
+            {
+                XXH64_state_t state;
+
+                XXH64_reset(&state, 0);
+
+                for(int i = 0; i < length; i += ChunkLength)
+                {
+                    const int count = length - i < ChunkLength ? length - i : ChunkLength;
+
+                    Text::Latin1Utility::WidenLatin1ToUtf16(chars + i, wide, count);
+                    XXH64_update(&state, wide, sizeof(utf16char) * count);
+                }
+
+                const XXH64_hash_t hash = XXH64_digest(&state);
+
+                return static_cast<int>(hash ^ (hash >> 32));
+            }
+
+            XXH32_state_t state;
+
+            XXH32_reset(&state, 0);
+
+            for(int i = 0; i < length; i += ChunkLength)
+            {
+                const int count = length - i < ChunkLength ? length - i : ChunkLength;
+
+                Text::Latin1Utility::WidenLatin1ToUtf16(chars + i, wide, count);
+                XXH32_update(&state, wide, sizeof(utf16char) * count);
+            }
+
+            return static_cast<int>(XXH32_digest(&state));
+        }
+
+        utf16char* String::InitializeStorage()
         {
+            if(IsInline())
+            {
+                return m_inline;
+            }
+
+            m_buffer = AllocateBuffer(m_length);
+
+            return m_buffer->Chars();
         }
 
-        String::String(const shared_ptr<utf16char[]> &str, const int length)
-            : m_string(str)
-            , m_length(length)
+        char* String::InitializeLatin1Storage()
         {
+            void *memory = DNN_Alloc(GetLatin1BufferSize(m_length));
+
+            if(!memory)
+            {
+                throw std::bad_alloc();
+            }
+
+            m_buffer = InitializeLatin1Buffer(memory, m_length);
+
+            char *chars = GetMutableLatin1Chars();
+
+            chars[m_length] = 0;
+
+            return chars;
         }
 
-        String::String(shared_ptr<utf16char[]> &&str, const int length)
-            : m_string(std::move(str))
-            , m_length(length)
+        void String::InitializeStorage(const utf16char *str)
         {
+            if(!IsInline() && Text::Latin1Utility::GetIndexOfFirstNonLatin1Char(str, m_length) == static_cast<size_t>(m_length))
+            {
+                Text::Latin1Utility::NarrowUtf16ToLatin1(str, InitializeLatin1Storage(), m_length);
+
+                return;
+            }
+
+            utf16char *chars = InitializeStorage();
+
+            memcpy(chars, str, sizeof(utf16char) * m_length);
+            chars[m_length] = 0;
         }
 
         String::String(const utf16char *str)
@@ -36,15 +304,11 @@ namespace DotNetNative
                 ++m_length;
             }
 
-            m_string = shared_ptr<utf16char[]>(DNN_New utf16char[static_cast<size_t>(m_length) + 1], Deleter<utf16char[]>(), DNN_Allocator(utf16char[]));
-
-            memcpy_s(m_string.get(), sizeof(utf16char) * (static_cast<size_t>(m_length) + 1), str, sizeof(utf16char) * m_length);
-
-            m_string.get()[m_length] = 0;
+            InitializeStorage(str);
         }
 
         String::String(const utf16char *str, const int length)
-            : m_length(length)
+            : m_length(0)
         {
             if(length < 0)
             {
@@ -56,14 +320,9 @@ namespace DotNetNative
                 throw ArgumentNullException();
             }
 
-            if(m_length > 0)
-            {
-                m_string = shared_ptr<utf16char[]>(DNN_New utf16char[static_cast<size_t>(m_length) + 1], Deleter<utf16char[]>(), DNN_Allocator(utf16char[]));
-
-                memcpy_s(m_string.get(), sizeof(utf16char) * (static_cast<size_t>(m_length) + 1), str, sizeof(utf16char) * m_length);
+            m_length = length;
 
-                m_string.get()[m_length] = 0;
-            }
+            InitializeStorage(str);
         }
 
         String::String(const char *str)
@@ -74,24 +333,21 @@ namespace DotNetNative
                 throw ArgumentNullException();
             }
 
-            while(str[m_length])
+            m_length = static_cast<int>(std::strlen(str));
+
+            if(IsInline())
             {
-                ++m_length;
+                Text::Latin1Utility::WidenLatin1ToUtf16(str, m_inline, m_length);
+                m_inline[m_length] = 0;
             }
-
-            m_string = shared_ptr<utf16char[]>(DNN_New utf16char[static_cast<size_t>(m_length) + 1], Deleter<utf16char[]>(), DNN_Allocator(utf16char[]));
-
-            for(int i = 0; i < m_length; ++i)
+            else
             {
-                // We assume ASCII
-                m_string.get()[i] = static_cast<utf16char>(str[i]);
+                memcpy(InitializeLatin1Storage(), str, m_length);
             }
-
-            m_string.get()[m_length] = 0;
         }
 
         String::String(const char *str, const int length)
-            : m_length(length)
+            : m_length(0)
         {
             if(length < 0)
             {
@@ -103,17 +359,16 @@ namespace DotNetNative
                 throw ArgumentNullException();
             }
 
-            if(m_length > 0)
-            {
-                m_string = shared_ptr<utf16char[]>(DNN_New utf16char[static_cast<size_t>(m_length) + 1], Deleter<utf16char[]>(), DNN_Allocator(utf16char[]));
-
-                for(int i = 0; i < m_length; ++i)
-                {
-                    // We assume ASCII
-                    m_string.get()[i] = static_cast<utf16char>(str[i]);
-                }
+            m_length = length;
 
-                m_string.get()[m_length] = 0;
+            if(IsInline())
+            {
+                Text::Latin1Utility::WidenLatin1ToUtf16(str, m_inline, m_length);
+                m_inline[m_length] = 0;
+            }
+            else
+            {
+                memcpy(InitializeLatin1Storage(), str, m_length);
             }
         }
         
@@ -130,18 +385,18 @@ namespace DotNetNative
                 ++m_length;
             }
 
-            m_string = shared_ptr<utf16char[]>(DNN_New utf16char[static_cast<size_t>(m_length) + 1], Deleter<utf16char[]>(), DNN_Allocator(utf16char[]));
+            utf16char *chars = InitializeStorage();
 
             for(int i = 0; i < m_length; ++i)
             {
-                m_string.get()[i] = static_cast<utf16char>(str[i]);
+                chars[i] = static_cast<utf16char>(str[i]);
             }
 
-            m_string.get()[m_length] = 0;
+            chars[m_length] = 0;
         }
 
         String::String(const Char *str, const int length)
-            : m_length(length)
+            : m_length(0)
         {
             if(length < 0)
             {
@@ -153,39 +408,64 @@ namespace DotNetNative
                 throw ArgumentNullException();
             }
 
-            if(m_length > 0)
-            {
-                m_string = shared_ptr<utf16char[]>(DNN_New utf16char[static_cast<size_t>(m_length) + 1], Deleter<utf16char[]>(), DNN_Allocator(utf16char[]));
+            m_length = length;
 
-                for(int i = 0; i < m_length; ++i)
-                {
-                    // We assume ASCII
-                    m_string.get()[i] = static_cast<utf16char>(str[i]);
-                }
+            utf16char *chars = InitializeStorage();
 
-                m_string.get()[m_length] = 0;
+            for(int i = 0; i < m_length; ++i)
+            {
+                // We assume ASCII
+                chars[i] = static_cast<utf16char>(str[i]);
             }
+
+            chars[m_length] = 0;
         }
 
         String::String(const String &copy)
-            : m_string(copy.m_string)
-            , m_length(copy.m_length)
+            : m_length(copy.m_length)
+            , m_atomId(copy.m_atomId)
         {
+            if(IsInline())
+            {
+                memcpy(m_inline, copy.m_inline, sizeof(m_inline));
+            }
+            else
+            {
+                m_buffer = copy.m_buffer;
+
+                AddRef(m_buffer);
+            }
         }
 
         String::String(String &&mov) noexcept
-            : m_string(std::move(mov.m_string))
-            , m_length(mov.m_length)
+            : m_length(mov.m_length)
+            , m_atomId(mov.m_atomId)
         {
+            // Copies whichever representation is in use.
+            memcpy(m_inline, mov.m_inline, sizeof(m_inline));
+
+            mov.m_inline[0] = 0;
             mov.m_length = 0;
+            mov.m_atomId = 0;
         }
 
         String& String::operator=(const String &copy)
         {
             if(this != &copy)
             {
+                if(!copy.IsInline())
+                {
+                    AddRef(copy.m_buffer);
+                }
+
+                if(!IsInline())
+                {
+                    Release(m_buffer);
+                }
+
+                memcpy(m_inline, copy.m_inline, sizeof(m_inline));
                 m_length = copy.m_length;
-                m_string = copy.m_string;
+                m_atomId = copy.m_atomId;
             }
 
             return *this;
@@ -195,33 +475,41 @@ namespace DotNetNative
         {
             if(this != &mov)
             {
-                m_string = std::move(mov.m_string);
+                if(!IsInline())
+                {
+                    Release(m_buffer);
+                }
+
+                memcpy(m_inline, mov.m_inline, sizeof(m_inline));
                 m_length = mov.m_length;
+                m_atomId = mov.m_atomId;
 
+                mov.m_inline[0] = 0;
                 mov.m_length = 0;
+                mov.m_atomId = 0;
             }
 
             return *this;
         }
 
-        String::operator const utf16char*() const noexcept
+        String::operator const utf16char*() const
         {
-            return static_cast<const utf16char*>(m_string.get());
+            return GetChars();
         }
 
         utf16char String::operator[](const int index) const
         {
-            if(index < 0 && index >= m_length)
+            if(index < 0 || index >= m_length)
             {
                 throw IndexOutOfRangeException();
             }
 
-            return m_string.get()[index];
+            return GetChar(index);
         }
 
         unique_ptr<Collections::IEnumerator<utf16char>> String::GetEnumerator()
         {
-            return unique_ptr<Collections::IEnumerator<utf16char>>(DNN_New CharEnumerator(m_string, m_length));
+            return unique_ptr<Collections::IEnumerator<utf16char>>(DNN_New CharEnumerator(*this));
         }
 
         bool String::Equals(const String &obj) const noexcept
@@ -231,136 +519,780 @@ namespace DotNetNative
                 return true;
             }
 
+            if(m_atomId != 0 && obj.m_atomId != 0)
+            {
+                return m_atomId == obj.m_atomId;
+            }
+
             if(m_length != obj.m_length)
             {
                 return false;
             }
 
-            if(m_length == 0)
+            if(!IsInline() && m_buffer == obj.m_buffer)
             {
                 return true;
             }
 
-            return memcmp(m_string.get(), obj.m_string.get(), sizeof(utf16char) * m_length) == 0;
+            return VisitChars([&obj](const auto *chars) { return obj.VisitChars([chars, &obj](const auto *objChars) { return SpanHelpers::SequenceEqual(chars, objChars, obj.m_length); }); });
         }
 
-        String String::ToString()
+        bool String::Equals(const StringSegment &obj) const noexcept
         {
-            return *this;
+            return obj.Equals(*this);
         }
 
-        bool String::IsNullOrEmpty(const String &str)
+        int String::CompareOrdinal(const String &strA, const String &strB) noexcept
         {
-            return 0u >= static_cast<unsigned int>(str.Length());
+            if(strA.m_atomId != 0 && strA.m_atomId == strB.m_atomId)
+            {
+                return 0;
+            }
+
+            return strA.VisitChars([&strA, &strB](const auto *charsA)
+            {
+                return strB.VisitChars([&strA, &strB, charsA](const auto *charsB) { return SpanHelpers::SequenceCompareTo(charsA, strA.m_length, charsB, strB.m_length); });
+            });
         }
 
-        bool String::IsNullOrWhiteSpace(const String &str)
+        int String::GetHashCode() const
         {
-            // avoid the bounds checking for each iteration
-            const utf16char *strPtr = str;
+            if(IsInline())
+            {
+                return ComputeHashCode(m_inline, m_length);
+            }
 
-            for(int i = 0; i < str.Length(); ++i)
+            // Zero marks a hash that was not computed yet, strings that hash to zero compute it every time.
+            int hashCode = m_buffer->m_hashCode;
+
+            if(hashCode == 0)
             {
-                if(!Char::IsWhiteSpace(strPtr[i]))
-                {
-                    return false;
-                }
+                hashCode = IsLatin1() ? ComputeHashCode(GetLatin1Chars(), m_length) : ComputeHashCode(m_buffer->Chars(), m_length);
+                m_buffer->m_hashCode = hashCode;
             }
 
-            return true;
+            return hashCode;
         }
 
-        bool operator==(const String &str1, const String &str2)
+        int String::IndexOf(const utf16char value) const noexcept
         {
-            return str1.Equals(str2);
+            return VisitChars([this, value](const auto *chars) { return SpanHelpers::IndexOf(chars, m_length, value); });
         }
 
-        bool operator==(const char *str1, const String &str2)
+        int String::IndexOf(const utf16char value, const int startIndex) const
         {
-            return str2 == str1;
+            if(startIndex < 0 || startIndex > m_length)
+            {
+                throw ArgumentOutOfRangeException("startIndex");
+            }
+
+            const int index = VisitChars([this, value, startIndex](const auto *chars) { return SpanHelpers::IndexOf(chars + startIndex, m_length - startIndex, value); });
+
+            return index < 0 ? -1 : index + startIndex;
         }
 
-        bool operator==(const String &str1, const char *str2)
+        int String::IndexOf(const String &value) const noexcept
         {
-            if(!str2 || !*str2)
-            {
-                return str1.Length() == 0;
-            }
+            return IndexOf(value, 0);
+        }
 
-            if(str1.Length() == 0)
+        int String::IndexOf(const String &value, const int startIndex) const
+        {
+            if(startIndex < 0 || startIndex > m_length)
             {
-                return false;
+                throw ArgumentOutOfRangeException("startIndex");
             }
 
-            const utf16char *str1Ptr = str1.m_string.get();
-
-            while(true)
+            const int index = VisitChars([this, &value, startIndex](const auto *chars)
             {
-                if(*str1Ptr == 0)
-                {
-                    return *str2 == 0;
-                }
+                return value.VisitChars([this, &value, startIndex, chars](const auto *valueChars) { return SpanHelpers::IndexOf(chars + startIndex, m_length - startIndex, valueChars, value.m_length); });
+            });
 
-                if(*str2 == 0)
-                {
-                    return *str1Ptr == 0;
-                }
+            return index < 0 ? -1 : index + startIndex;
+        }
 
-                if(*str1Ptr != *str2)
-                {
-                    return false;
-                }
+        int String::IndexOf(const StringSegment &value) const noexcept
+        {
+            return VisitChars([this, &value](const auto *chars) { return SpanHelpers::IndexOf(chars, m_length, value.Data(), value.Length()); });
+        }
 
-                ++str1Ptr;
-                ++str2;
+        int String::IndexOfAny(const utf16char *anyOf, const int count) const
+        {
+            if(count < 0)
+            {
+                throw ArgumentOutOfRangeException("count");
+            }
+
+            if(!anyOf && count > 0)
+            {
+                throw ArgumentNullException("anyOf");
             }
 
-            // This should be inaccessible
-            return true;
+            return VisitChars([this, anyOf, count](const auto *chars) { return SpanHelpers::IndexOfAny(chars, m_length, anyOf, count); });
         }
 
-        bool operator==(const utf16char *str1, const String &str2)
+        int String::LastIndexOf(const utf16char value) const noexcept
         {
-            return str2 == str1;
+            return VisitChars([this, value](const auto *chars) { return SpanHelpers::LastIndexOf(chars, m_length, value); });
         }
 
-        bool operator==(const String &str1, const utf16char *str2)
+        int String::LastIndexOf(const String &value) const noexcept
         {
-            if(!str2 || !*str2)
+            return VisitChars([this, &value](const auto *chars)
             {
-                return str1.Length() == 0;
-            }
+                return value.VisitChars([this, &value, chars](const auto *valueChars) { return SpanHelpers::LastIndexOf(chars, m_length, valueChars, value.m_length); });
+            });
+        }
 
-            if(str1.Length() == 0)
-            {
-                return false;
-            }
+        bool String::Contains(const utf16char value) const noexcept
+        {
+            return IndexOf(value) >= 0;
+        }
 
-            const utf16char *str1Ptr = str1.m_string.get();
+        bool String::Contains(const String &value) const noexcept
+        {
+            return IndexOf(value) >= 0;
+        }
+
+        bool String::Contains(const StringSegment &value) const noexcept
+        {
+            return IndexOf(value) >= 0;
+        }
+
+        bool String::StartsWith(const utf16char value) const noexcept
+        {
+            return m_length > 0 && GetChar(0) == value;
+        }
 
-            while(true)
+        bool String::StartsWith(const String &value) const noexcept
+        {
+            return value.m_length <= m_length && VisitChars([&value](const auto *chars)
             {
-                if(*str1Ptr == 0)
-                {
-                    return *str2 == 0;
-                }
+                return value.VisitChars([&value, chars](const auto *valueChars) { return SpanHelpers::SequenceEqual(chars, valueChars, value.m_length); });
+            });
+        }
 
-                if(*str2 == 0)
-                {
-                    return *str1Ptr == 0;
-                }
+        bool String::StartsWith(const StringSegment &value) const noexcept
+        {
+            return value.Length() <= m_length && VisitChars([&value](const auto *chars) { return SpanHelpers::SequenceEqual(chars, value.Data(), value.Length()); });
+        }
 
-                if(*str1Ptr != *str2)
-                {
-                    return false;
-                }
+        bool String::EndsWith(const utf16char value) const noexcept
+        {
+            return m_length > 0 && GetChar(m_length - 1) == value;
+        }
 
-                ++str1Ptr;
-                ++str2;
-            }
+        bool String::EndsWith(const String &value) const noexcept
+        {
+            return value.m_length <= m_length && VisitChars([this, &value](const auto *chars)
+            {
+                return value.VisitChars([this, &value, chars](const auto *valueChars) { return SpanHelpers::SequenceEqual(chars + m_length - value.m_length, valueChars, value.m_length); });
+            });
+        }
 
-            // This should be inaccessible
-            return true;
+        bool String::EndsWith(const StringSegment &value) const noexcept
+        {
+            return value.Length() <= m_length && VisitChars([this, &value](const auto *chars) { return SpanHelpers::SequenceEqual(chars + m_length - value.Length(), value.Data(), value.Length()); });
+        }
+
+        StringSplitEnumerator String::Split(const utf16char separator, const StringSplitOptions options) const
+        {
+            return StringSplitEnumerator(*this, separator, options);
+        }
+
+        StringSplitEnumerator String::Split(const utf16char *separators, const int count, const StringSplitOptions options) const
+        {
+            return StringSplitEnumerator(*this, separators, count, options);
+        }
+
+        StringSplitEnumerator String::Split(const String &separator, const StringSplitOptions options) const
+        {
+            return StringSplitEnumerator(*this, separator, options);
+        }
+
+        template <typename TIndexOf, typename TConvert>
+        String String::ConvertLatin1Case(TIndexOf indexOf, TConvert convert) const
+        {
+            // The conversion is defined on UTF-16, so the characters are widened on the stack a chunk at a time.
+            constexpr int ChunkLength = 64;
+            const char *chars = GetLatin1Chars();
+            utf16char wide[ChunkLength];
+            int index = -1;
+
+            for(int i = 0; i < m_length && index < 0; i += ChunkLength)
+            {
+                const int count = m_length - i < ChunkLength ? m_length - i : ChunkLength;
+
+                Text::Latin1Utility::WidenLatin1ToUtf16(chars + i, wide, count);
+                index = indexOf(wide, count);
+                index = index < 0 ? -1 : index + i;
+            }
+
+            if(index < 0)
+            {
+                return *this;
+            }
+
+            String str = FastAllocateLatin1String(m_length);
+            char *destination = str.GetMutableLatin1Chars();
+
+            memcpy(destination, chars, index);
+
+            for(int i = index; i < m_length; i += ChunkLength)
+            {
+                const int count = m_length - i < ChunkLength ? m_length - i : ChunkLength;
+
+                Text::Latin1Utility::WidenLatin1ToUtf16(chars + i, wide, count);
+                convert(wide, wide, count);
+
+                // A few characters convert to ones outside Latin-1 (U+00B5 and U+00FF to upper case).
+                if(Text::Latin1Utility::GetIndexOfFirstNonLatin1Char(wide, count) < static_cast<size_t>(count))
+                {
+                    String utf16 = FastAllocateString(m_length);
+                    utf16char *utf16Destination = utf16.GetMutableChars();
+
+                    Text::Latin1Utility::WidenLatin1ToUtf16(destination, utf16Destination, i);
+                    Text::Latin1Utility::WidenLatin1ToUtf16(chars + i, utf16Destination + i, m_length - i);
+                    convert(utf16Destination + i, utf16Destination + i, m_length - i);
+
+                    return utf16;
+                }
+
+                Text::Latin1Utility::NarrowUtf16ToLatin1(wide, destination + i, count);
+            }
+
+            return str;
+        }
+
+        String String::ToUpperInvariant() const
+        {
+            if(IsLatin1())
+            {
+                return ConvertLatin1Case(Globalization::InvariantCasing::IndexOfFirstCharToUpper, Globalization::InvariantCasing::ToUpper);
+            }
+
+            const utf16char *chars = GetUtf16Chars();
+            const int index = Globalization::InvariantCasing::IndexOfFirstCharToUpper(chars, m_length);
+
+            if(index < 0)
+            {
+                return *this;
+            }
+
+            String str = FastAllocateString(m_length);
+            utf16char *destination = str.GetMutableChars();
+
+            memcpy(destination, chars, sizeof(utf16char) * index);
+            Globalization::InvariantCasing::ToUpper(chars + index, destination + index, m_length - index);
+
+            return str;
+        }
+
+        String String::ToLowerInvariant() const
+        {
+            if(IsLatin1())
+            {
+                return ConvertLatin1Case(Globalization::InvariantCasing::IndexOfFirstCharToLower, Globalization::InvariantCasing::ToLower);
+            }
+
+            const utf16char *chars = GetUtf16Chars();
+            const int index = Globalization::InvariantCasing::IndexOfFirstCharToLower(chars, m_length);
+
+            if(index < 0)
+            {
+                return *this;
+            }
+
+            String str = FastAllocateString(m_length);
+            utf16char *destination = str.GetMutableChars();
+
+            memcpy(destination, chars, sizeof(utf16char) * index);
+            Globalization::InvariantCasing::ToLower(chars + index, destination + index, m_length - index);
+
+            return str;
+        }
+
+        String String::Trim() const
+        {
+            return TrimWhiteSpace(TrimType::Both);
+        }
+
+        String String::Trim(const utf16char trimChar) const
+        {
+            return TrimChars(&trimChar, 1, TrimType::Both);
+        }
+
+        String String::Trim(const utf16char *trimChars, const int count) const
+        {
+            return TrimChars(trimChars, count, TrimType::Both);
+        }
+
+        String String::TrimStart() const
+        {
+            return TrimWhiteSpace(TrimType::Head);
+        }
+
+        String String::TrimStart(const utf16char trimChar) const
+        {
+            return TrimChars(&trimChar, 1, TrimType::Head);
+        }
+
+        String String::TrimStart(const utf16char *trimChars, const int count) const
+        {
+            return TrimChars(trimChars, count, TrimType::Head);
+        }
+
+        String String::TrimEnd() const
+        {
+            return TrimWhiteSpace(TrimType::Tail);
+        }
+
+        String String::TrimEnd(const utf16char trimChar) const
+        {
+            return TrimChars(&trimChar, 1, TrimType::Tail);
+        }
+
+        String String::TrimEnd(const utf16char *trimChars, const int count) const
+        {
+            return TrimChars(trimChars, count, TrimType::Tail);
+        }
+
+        String String::TrimWhiteSpace(const TrimType type) const
+        {
+            return VisitChars([this, type](const auto *chars)
+            {
+                const int start = type != TrimType::Tail ? SpanHelpers::CountLeadingWhiteSpace(chars, m_length) : 0;
+                const int end = type != TrimType::Head ? m_length - SpanHelpers::CountTrailingWhiteSpace(chars + start, m_length - start) : m_length;
+
+                return Trimmed(start, end);
+            });
+        }
+
+        String String::TrimChars(const utf16char *trimChars, const int count, const TrimType type) const
+        {
+            if(!trimChars || count <= 0)
+            {
+                return TrimWhiteSpace(type);
+            }
+
+            int start = 0;
+            int end = m_length;
+
+            if(type != TrimType::Tail)
+            {
+                while(start < end && SpanHelpers::IndexOf(trimChars, count, GetChar(start)) >= 0)
+                {
+                    ++start;
+                }
+            }
+
+            if(type != TrimType::Head)
+            {
+                while(end > start && SpanHelpers::IndexOf(trimChars, count, GetChar(end - 1)) >= 0)
+                {
+                    --end;
+                }
+            }
+
+            return Trimmed(start, end);
+        }
+
+        String String::Trimmed(const int start, const int end) const
+        {
+            if(start == 0 && end == m_length)
+            {
+                return *this;
+            }
+
+            return VisitChars([start, end](const auto *chars) { return String(chars + start, end - start); });
+        }
+
+        String String::ToString()
+        {
+            return *this;
+        }
+
+        ///////////////////////////////////////////////////// InternPool /////////////////////////////////////////////////////
+
+        // Interned strings are spread over shards by hash code, each an open-addressing table of atom IDs behind a
+        // reader-writer lock, so lookups of strings that are already interned only take shared locks. The canonical
+        // Strings live in chunks indexed by atom ID that are never moved or freed.
+        //
+        // All of the pool's memory, including the buffers of canonical strings, comes from Memory's default backend
+        // rather than the current arena or allocator scope, since it lives until the process exits.
+        class String::InternPool
+        {
+        private:
+            static constexpr int ShardCount = 64;
+            static constexpr int ChunkSize = 4096;
+            static constexpr int MaxChunks = 4096;
+
+            struct Entry
+            {
+                int m_hashCode;
+                int m_atomId;       // 0 marks a free slot
+            };
+
+            struct Shard
+            {
+                std::shared_mutex m_lock;
+                Entry            *m_entries = nullptr;
+                int               m_capacity = 0;
+                int               m_count = 0;
+            };
+
+            Shard                m_shards[ShardCount];
+            std::mutex           m_atomLock;
+            std::atomic<int>     m_atomCount;
+            std::atomic<String*> m_chunks[MaxChunks];
+
+        private:
+            InternPool() noexcept
+                : m_atomCount(0)
+                , m_chunks{}
+            {
+            }
+
+            static void* Allocate(const size_t size)
+            {
+                const AllocatorHooks &hooks = Memory::GetDefaultAllocatorHooks();
+                void *memory = hooks.m_alloc(hooks.m_context, size);
+
+                if(!memory)
+                {
+                    throw std::bad_alloc();
+                }
+
+                return memory;
+            }
+
+            static void Free(void *memory, const size_t size) noexcept
+            {
+                const AllocatorHooks &hooks = Memory::GetDefaultAllocatorHooks();
+
+                hooks.m_sizedFree(hooks.m_context, memory, size);
+            }
+
+            inline Shard& GetShard(const int hashCode) noexcept
+            {
+                // The high bits pick the shard, the low ones the slot within it.
+                return m_shards[static_cast<uint32_t>(hashCode) >> 26];
+            }
+
+            inline const String& GetString(const int atomId) const noexcept
+            {
+                const int index = atomId - 1;
+
+                return m_chunks[index / ChunkSize].load(std::memory_order_acquire)[index % ChunkSize];
+            }
+
+            int Find(const Shard &shard, const String &str, const int hashCode) const noexcept
+            {
+                const int mask = shard.m_capacity - 1;
+
+                if(shard.m_capacity == 0)
+                {
+                    return 0;
+                }
+
+                for(int i = hashCode & mask; shard.m_entries[i].m_atomId != 0; i = (i + 1) & mask)
+                {
+                    const Entry &entry = shard.m_entries[i];
+
+                    if(entry.m_hashCode == hashCode && GetString(entry.m_atomId).Equals(str))
+                    {
+                        return entry.m_atomId;
+                    }
+                }
+
+                return 0;
+            }
+
+            void Insert(Shard &shard, const int hashCode, const int atomId)
+            {
+                if((shard.m_count + 1) * 2 > shard.m_capacity)
+                {
+                    const int capacity = shard.m_capacity == 0 ? 64 : shard.m_capacity * 2;
+                    Entry *entries = static_cast<Entry*>(Allocate(sizeof(Entry) * capacity));
+
+                    memset(entries, 0, sizeof(Entry) * capacity);
+
+                    for(int i = 0; i < shard.m_capacity; ++i)
+                    {
+                        const Entry &entry = shard.m_entries[i];
+
+                        if(entry.m_atomId != 0)
+                        {
+                            int slot = entry.m_hashCode & (capacity - 1);
+
+                            while(entries[slot].m_atomId != 0)
+                            {
+                                slot = (slot + 1) & (capacity - 1);
+                            }
+
+                            entries[slot] = entry;
+                        }
+                    }
+
+                    if(shard.m_entries)
+                    {
+                        Free(shard.m_entries, sizeof(Entry) * shard.m_capacity);
+                    }
+
+                    shard.m_entries = entries;
+                    shard.m_capacity = capacity;
+                }
+
+                int slot = hashCode & (shard.m_capacity - 1);
+
+                while(shard.m_entries[slot].m_atomId != 0)
+                {
+                    slot = (slot + 1) & (shard.m_capacity - 1);
+                }
+
+                shard.m_entries[slot] = { hashCode, atomId };
+                ++shard.m_count;
+            }
+
+            // Stores a canonical copy of str under a new atom ID.
+            int AddAtom(const String &str)
+            {
+                std::lock_guard<std::mutex> lock(m_atomLock);
+
+                const int atomId = m_atomCount.load(std::memory_order_relaxed) + 1;
+                const int chunk = (atomId - 1) / ChunkSize;
+
+                if(chunk >= MaxChunks)
+                {
+                    throw InvalidOperationException("The intern pool is full.");
+                }
+
+                String *strings = m_chunks[chunk].load(std::memory_order_relaxed);
+
+                if(!strings)
+                {
+                    strings = static_cast<String*>(Allocate(sizeof(String) * ChunkSize));
+                    m_chunks[chunk].store(strings, std::memory_order_release);
+                }
+
+                String *canonical = new (&strings[(atomId - 1) % ChunkSize]) String();
+
+                canonical->m_length = str.m_length;
+
+                if(str.IsLatin1())
+                {
+                    canonical->m_buffer = InitializeLatin1Buffer(Allocate(GetLatin1BufferSize(str.m_length)), str.m_length);
+                    canonical->m_buffer->m_hashCode = str.GetHashCode();
+                    canonical->m_buffer->m_flags |= Buffer::StaticFlag;
+
+                    memcpy(canonical->GetMutableLatin1Chars(), str.GetLatin1Chars(), static_cast<size_t>(str.m_length) + 1);
+                }
+                else
+                {
+                    if(!str.IsInline())
+                    {
+                        canonical->m_buffer = InitializeBuffer(Allocate(GetBufferSize(str.m_length)), str.m_length);
+                        canonical->m_buffer->m_hashCode = str.GetHashCode();
+                        canonical->m_buffer->m_flags = Buffer::StaticFlag;
+                    }
+
+                    memcpy(canonical->GetMutableChars(), str.GetUtf16Chars(), sizeof(utf16char) * (static_cast<size_t>(str.m_length) + 1));
+                }
+
+                canonical->m_atomId = atomId;
+
+                m_atomCount.store(atomId, std::memory_order_release);
+
+                return atomId;
+            }
+
+        public:
+            static InternPool& Instance()
+            {
+                // Never destroyed, so that interned strings stay valid in static destructors.
+                static InternPool *pool = new (Allocate(sizeof(InternPool))) InternPool();
+
+                return *pool;
+            }
+
+            String Intern(const String &str)
+            {
+                const int hashCode = str.GetHashCode();
+                Shard &shard = GetShard(hashCode);
+
+                {
+                    std::shared_lock<std::shared_mutex> lock(shard.m_lock);
+
+                    if(const int atomId = Find(shard, str, hashCode))
+                    {
+                        return GetString(atomId);
+                    }
+                }
+
+                std::unique_lock<std::shared_mutex> lock(shard.m_lock);
+                int atomId = Find(shard, str, hashCode);
+
+                if(atomId == 0)
+                {
+                    atomId = AddAtom(str);
+                    Insert(shard, hashCode, atomId);
+                }
+
+                return GetString(atomId);
+            }
+
+            bool IsInterned(const String &str)
+            {
+                const int hashCode = str.GetHashCode();
+                Shard &shard = GetShard(hashCode);
+                std::shared_lock<std::shared_mutex> lock(shard.m_lock);
+
+                return Find(shard, str, hashCode) != 0;
+            }
+
+            String FromAtomId(const int atomId) const
+            {
+                if(atomId <= 0 || atomId > m_atomCount.load(std::memory_order_acquire))
+                {
+                    throw ArgumentOutOfRangeException("Unknown atom ID.");
+                }
+
+                return GetString(atomId);
+            }
+        };
+
+        String String::Intern(const String &str)
+        {
+            if(str.m_atomId != 0)
+            {
+                return str;
+            }
+
+            return InternPool::Instance().Intern(str);
+        }
+
+        bool String::IsInterned(const String &str)
+        {
+            return str.m_atomId != 0 || InternPool::Instance().IsInterned(str);
+        }
+
+        String String::FromAtomId(const int atomId)
+        {
+            return InternPool::Instance().FromAtomId(atomId);
+        }
+
+        bool String::IsNullOrEmpty(const String &str)
+        {
+            return 0u >= static_cast<unsigned int>(str.Length());
+        }
+
+        bool String::IsNullOrWhiteSpace(const String &str)
+        {
+            return str.VisitChars([&str](const auto *chars) { return SpanHelpers::CountLeadingWhiteSpace(chars, str.m_length) == str.m_length; });
+        }
+
+        bool operator==(const String &str1, const String &str2)
+        {
+            return str1.Equals(str2);
+        }
+
+        bool operator==(const char *str1, const String &str2)
+        {
+            return str2 == str1;
+        }
+
+        bool operator==(const String &str1, const char *str2)
+        {
+            if(!str2)
+            {
+                return str1.Length() == 0;
+            }
+
+            const size_t length = std::strlen(str2);
+
+            return length == static_cast<size_t>(str1.Length()) && str1.VisitChars([str2, length](const auto *chars) { return SpanHelpers::SequenceEqual(chars, str2, length); });
+        }
+
+        bool operator==(const utf16char *str1, const String &str2)
+        {
+            return str2 == str1;
+        }
+
+        bool operator==(const String &str1, const utf16char *str2)
+        {
+            if(!str2)
+            {
+                return str1.Length() == 0;
+            }
+
+            const size_t length = SpanHelpers::IndexOfNullCharacter(str2);
+
+            return length == static_cast<size_t>(str1.Length()) && str1.VisitChars([str2, length](const auto *chars) { return SpanHelpers::SequenceEqual(chars, str2, length); });
+        }
+
+        bool operator<(const String &str1, const String &str2)
+        {
+            return String::CompareOrdinal(str1, str2) < 0;
+        }
+
+        namespace Internal
+        {
+            int FormatNumber(const int64_t value, char *destination) noexcept
+            {
+                return static_cast<int>(std::to_chars(destination, destination + NumberBufferLength, value).ptr - destination);
+            }
+
+            int FormatNumber(const uint64_t value, char *destination) noexcept
+            {
+                return static_cast<int>(std::to_chars(destination, destination + NumberBufferLength, value).ptr - destination);
+            }
+
+            template <typename T>
+            static int FormatFloatingPoint(const T value, char *destination) noexcept
+            {
+                const char *special = nullptr;
+
+                if(std::isnan(value))
+                {
+                    special = "NaN";
+                }
+                else if(std::isinf(value))
+                {
+                    special = value < 0 ? "-Infinity" : "Infinity";
+                }
+
+                if(special)
+                {
+                    const size_t length = strlen(special);
+
+                    memcpy(destination, special, length);
+
+                    return static_cast<int>(length);
+                }
+
+                char *end = std::to_chars(destination, destination + NumberBufferLength, value).ptr;
+
+                // Like .NET, write the exponent with a capital E ("1E+20").
+                for(char *c = destination; c < end; ++c)
+                {
+                    if(*c == 'e')
+                    {
+                        *c = 'E';
+                    }
+                }
+
+                return static_cast<int>(end - destination);
+            }
+
+            int FormatNumber(const float value, char *destination) noexcept
+            {
+                return FormatFloatingPoint(value, destination);
+            }
+
+            int FormatNumber(const double value, char *destination) noexcept
+            {
+                return FormatFloatingPoint(value, destination);
+            }
         }
     }
 }
\ No newline at end of file
@@ -4,23 +4,163 @@
 #include "Char.h"
 #include "Collections/IEnumerable.h"
 #include "Exception.h"
+#include "StringSplitOptions.h"
+#include "Text/Latin1Utility.h"
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+
+// A String for a string literal (u"..." or ASCII "..."), kept in a constant-initialized static StringLiteral, so
+// that it is neither copied to the heap nor reference counted.
+#define DNN_STRING(str) ([]() noexcept -> ::DotNetNative::System::String { static ::DotNetNative::System::StringLiteral literal(str); return ::DotNetNative::System::String(literal); }())
 
 namespace DotNetNative
 {
     namespace System
     {
+        class StringSegment;
+        class StringSplitEnumerator;
+        template <size_t N> class StringLiteral;
+
+        namespace Internal
+        {
+            template <typename T, typename> struct StringPart;
+        }
+
         class String
             : public Object
             , public Collections::IEnumerable<utf16char>
         {
             friend class StringBuilder;
+            friend class StringComparer;
+            friend class StringSegment;
+            template <size_t N> friend class StringLiteral;
+            template <typename T, typename> friend struct Internal::StringPart;
         private:
-            shared_ptr<utf16char[]> m_string;
-            int                     m_length;
+            // Strings of up to InlineCapacity characters are stored in the object, longer ones in a shared Buffer, with a
+            // byte per character when they are all Latin-1 (see Latin1Buffer).
+            static constexpr int InlineCapacity = 11;
+
+            // A single block holding the header, the characters and the terminator. Compile with
+            // DNN_SINGLE_THREADED_STRINGS to use a plain reference count when Strings never cross threads.
+            struct Buffer
+            {
+#ifdef DNN_SINGLE_THREADED_STRINGS
+                int              m_refCount;
+                int              m_hashCode;
+#else
+                std::atomic<int> m_refCount;
+                std::atomic<int> m_hashCode;
+#endif
+                int              m_length;
+                uint32_t         m_flags;
+
+                // The buffer is in static storage (a StringLiteral or an interned string) and is never released, so
+                // its reference count is left alone.
+                static constexpr uint32_t StaticFlag = 1;
+                // The buffer is a Latin1Buffer.
+                static constexpr uint32_t Latin1Flag = 2;
+
+                inline utf16char* Chars() noexcept { return reinterpret_cast<utf16char*>(this + 1); }
+            };
+
+            // The buffer of a string whose characters are all Latin-1, stored one byte each. Pointers to its characters
+            // as utf16char get a widened copy, made on the first request and kept until the buffer is released.
+            struct Latin1Buffer : Buffer
+            {
+#ifdef DNN_SINGLE_THREADED_STRINGS
+                utf16char               *m_wideChars;
+#else
+                std::atomic<utf16char*>  m_wideChars;
+#endif
+
+                inline char* Latin1Chars() noexcept { return reinterpret_cast<char*>(this + 1); }
+            };
+
+            union
+            {
+                Buffer    *m_buffer;
+                utf16char  m_inline[InlineCapacity + 1];
+            };
+            int            m_length;
+            int            m_atomId = 0;
+
+            class InternPool;
 
         private:
-            String(const shared_ptr<utf16char[]> &str, const int length);
-            String(shared_ptr<utf16char[]> &&str, const int length);
+            // Returns a string of length uninitialized characters and a terminator, to be filled in through GetMutableChars().
+            static String FastAllocateString(const int length);
+            // The same for a string longer than InlineCapacity whose characters are all Latin-1, to be filled in
+            // through GetMutableLatin1Chars().
+            static String FastAllocateLatin1String(const int length);
+
+            static Buffer* AllocateBuffer(const int length);
+            static Buffer* InitializeBuffer(void *memory, const int length) noexcept;
+            static Buffer* InitializeLatin1Buffer(void *memory, const int length) noexcept;
+            static inline size_t GetBufferSize(const int length) noexcept { return sizeof(Buffer) + sizeof(utf16char) * (static_cast<size_t>(length) + 1); }
+            static inline size_t GetLatin1BufferSize(const int length) noexcept { return sizeof(Latin1Buffer) + static_cast<size_t>(length) + 1; }
+            static int ComputeHashCode(const utf16char *chars, const int length) noexcept;
+            // Equal to the hash code of the same characters as UTF-16.
+            static int ComputeHashCode(const char *chars, const int length) noexcept;
+            static void AddRef(Buffer *buffer) noexcept;
+            static void Release(Buffer *buffer) noexcept;
+
+            inline bool IsInline() const noexcept { return m_length <= InlineCapacity; }
+            inline bool IsLatin1() const noexcept { return !IsInline() && (m_buffer->m_flags & Buffer::Latin1Flag) != 0; }
+            // The characters of a string that is not Latin-1.
+            inline const utf16char* GetUtf16Chars() const noexcept { return IsInline() ? m_inline : m_buffer->Chars(); }
+            inline const char* GetLatin1Chars() const noexcept { return static_cast<Latin1Buffer*>(m_buffer)->Latin1Chars(); }
+            inline char* GetMutableLatin1Chars() noexcept { return static_cast<Latin1Buffer*>(m_buffer)->Latin1Chars(); }
+            // Widens the characters of a Latin-1 string on the first call.
+            inline const utf16char* GetChars() const { return IsLatin1() ? GetWideChars() : GetUtf16Chars(); }
+            const utf16char* GetWideChars() const;
+            inline utf16char* GetMutableChars() noexcept { return IsInline() ? m_inline : m_buffer->Chars(); }
+            inline utf16char GetChar(const int index) const noexcept { return IsLatin1() ? static_cast<unsigned char>(GetLatin1Chars()[index]) : GetUtf16Chars()[index]; }
+
+            // Calls func with the characters as a const utf16char*, or as a const char* for a Latin-1 string.
+            template <typename TFunc>
+            inline auto VisitChars(TFunc &&func) const
+            {
+                return IsLatin1() ? func(GetLatin1Chars()) : func(GetUtf16Chars());
+            }
+
+            // Writes the characters (without a terminator) to destination.
+            void CopyTo(utf16char *destination) const noexcept;
+
+            // Sets up the storage for m_length characters and returns it; the caller writes the characters and terminator.
+            utf16char* InitializeStorage();
+            // The same for a Latin-1 buffer, m_length must be above InlineCapacity. The terminator is written.
+            char* InitializeLatin1Storage();
+            // Stores the characters in a Latin-1 buffer when the string is too long to be inline and they all fit a byte.
+            void InitializeStorage(const utf16char *str);
+
+            template <typename... TParts>
+            static String ConcatParts(const TParts&... parts);
+
+            enum class TrimType
+            {
+                Head,
+                Tail,
+                Both
+            };
+
+            String TrimWhiteSpace(const TrimType type) const;
+            String TrimChars(const utf16char *trimChars, const int count, const TrimType type) const;
+            // Returns the characters from start to end, or this string when they are all of it.
+            String Trimmed(const int start, const int end) const;
+
+            // ToUpperInvariant or ToLowerInvariant of a Latin-1 string, given the InvariantCasing functions.
+            template <typename TIndexOf, typename TConvert>
+            String ConvertLatin1Case(TIndexOf indexOf, TConvert convert) const;
+
+            template <size_t N>
+            constexpr String(StringLiteral<N> &literal, std::true_type isInline) noexcept;
+            template <size_t N>
+            constexpr String(StringLiteral<N> &literal, std::false_type isInline) noexcept;
 
         public:
             String() noexcept;
@@ -32,15 +172,39 @@ namespace DotNetNative
             String(const Char *str, const int length);
             String(const String &copy);
             String(String &&mov) noexcept;
-            virtual ~String(){}
+            // Refers to the characters of a literal without copying them to the heap or counting references. Being
+            // constexpr, static Strings made from literals are constant-initialized.
+            template <size_t N>
+            constexpr String(StringLiteral<N> &literal) noexcept : String(literal, std::integral_constant<bool, N - 1 <= InlineCapacity>()) {}
+            // A u"" literal short enough to be stored inline, also constant-initialized when static.
+            template <size_t N, typename = typename std::enable_if<N - 1 <= InlineCapacity>::type>
+            constexpr String(const char16_t (&str)[N]) noexcept
+                : m_inline{}
+                , m_length(static_cast<int>(N - 1))
+            {
+                for(size_t i = 0; i < N; ++i)
+                {
+                    m_inline[i] = static_cast<utf16char>(str[i]);
+                }
+            }
+            virtual ~String();
 
             String& operator=(const String &copy);
             String& operator=(String &&mov) noexcept;
 
             utf16char operator[](const int index) const;
-            operator const utf16char*() const noexcept;
+            // The characters of a Latin-1 string are widened on the first call, which may throw std::bad_alloc.
+            operator const utf16char*() const;
 
             bool Equals(const String &obj) const noexcept;
+            bool Equals(const StringSegment &obj) const noexcept;
+
+            // Compares the strings by UTF-16 code unit values, returning a negative value, zero or a positive value
+            // when strA orders before, with or after strB.
+            static int CompareOrdinal(const String &strA, const String &strB) noexcept;
+
+            // Hashes the characters with xxHash. Strings on the heap compute it once and keep it in their buffer.
+            virtual int GetHashCode() const override;
             virtual String ToString() override;
 
             //
@@ -53,6 +217,75 @@ namespace DotNetNative
 
             inline int Length() const noexcept { return m_length; }
 
+            // Ordinal searches, returning the index of the first (or last) match or -1. Single characters are scanned
+            // a vector at a time, see SpanHelpers for substrings.
+            int IndexOf(const utf16char value) const noexcept;
+            int IndexOf(const utf16char value, const int startIndex) const;
+            int IndexOf(const String &value) const noexcept;
+            int IndexOf(const String &value, const int startIndex) const;
+            int IndexOf(const StringSegment &value) const noexcept;
+            int IndexOfAny(const utf16char *anyOf, const int count) const;
+            int LastIndexOf(const utf16char value) const noexcept;
+            int LastIndexOf(const String &value) const noexcept;
+
+            bool Contains(const utf16char value) const noexcept;
+            bool Contains(const String &value) const noexcept;
+            bool Contains(const StringSegment &value) const noexcept;
+            bool StartsWith(const utf16char value) const noexcept;
+            bool StartsWith(const String &value) const noexcept;
+            bool StartsWith(const StringSegment &value) const noexcept;
+            bool EndsWith(const utf16char value) const noexcept;
+            bool EndsWith(const String &value) const noexcept;
+            bool EndsWith(const StringSegment &value) const noexcept;
+
+            // Lazily splits the string into segments that share its buffer, see StringSplitEnumerator. An empty char set
+            // splits at white space, an empty separator string doesn't split.
+            StringSplitEnumerator Split(const utf16char separator, const StringSplitOptions options = StringSplitOptions::None) const;
+            StringSplitEnumerator Split(const utf16char *separators, const int count, const StringSplitOptions options = StringSplitOptions::None) const;
+            StringSplitEnumerator Split(const String &separator, const StringSplitOptions options = StringSplitOptions::None) const;
+
+            // Converts the characters with the invariant culture's simple case mappings, see CharUnicodeInfo::ToUpper.
+            // Returns this string when no character changes.
+            String ToUpperInvariant() const;
+            String ToLowerInvariant() const;
+
+            // Remove white space, or the characters in trimChars, from both ends, the start or the end of the string.
+            // An empty set of characters removes white space. Returns this string when nothing is removed.
+            String Trim() const;
+            String Trim(const utf16char trimChar) const;
+            String Trim(const utf16char *trimChars, const int count) const;
+            String TrimStart() const;
+            String TrimStart(const utf16char trimChar) const;
+            String TrimStart(const utf16char *trimChars, const int count) const;
+            String TrimEnd() const;
+            String TrimEnd(const utf16char trimChar) const;
+            String TrimEnd(const utf16char *trimChars, const int count) const;
+
+            // The ID of the interned string this String was returned by Intern for (or copied from), otherwise 0.
+            inline int AtomId() const noexcept { return m_atomId; }
+
+            // Returns the canonical String with the characters of str, adding one to the intern pool if there is none.
+            // Interned strings share a single buffer and are never released. Two interned strings are equal exactly when
+            // their atom IDs are, which Equals checks before comparing characters.
+            static String Intern(const String &str);
+            static bool IsInterned(const String &str);
+            // Returns the interned string with the given atom ID.
+            static String FromAtomId(const int atomId);
+
+            // Concatenates the arguments into a single exactly sized String: every part is measured first, then written
+            // in place. Accepts Strings, StringSegments (which also wrap utf16char spans), null-terminated char and
+            // utf16char strings, single char and utf16char characters, bool and numbers. A null string is empty.
+            template <typename... TArgs>
+            static String Concat(const TArgs&... args);
+
+            // Concatenates the values with the separator between them in a single exactly sized String. The values
+            // and the separator can be of any type Concat accepts; the values are traversed twice, to measure and
+            // to write.
+            template <typename TSeparator, typename TIterator>
+            static String Join(const TSeparator &separator, TIterator first, const TIterator last);
+            template <typename TSeparator, typename TRange>
+            static String Join(const TSeparator &separator, const TRange &values);
+
             static bool IsNullOrEmpty(const String &str);
             static bool IsNullOrWhiteSpace(const String &str);
 
@@ -60,11 +293,358 @@ namespace DotNetNative
             friend bool operator==(const String &str1, const utf16char *str2);
         };
 
+        // The header and characters of a String in static storage. Declare literals as static (but not const, the
+        // hash code is cached in them) so that they are constant-initialized, or use DNN_STRING.
+        template <size_t N>
+        class StringLiteral
+        {
+            friend class String;
+        private:
+            String::Buffer m_buffer;
+            utf16char      m_chars[N];
+
+        public:
+            constexpr StringLiteral(const char16_t (&str)[N]) noexcept
+                : m_buffer{ 1, 0, static_cast<int>(N - 1), String::Buffer::StaticFlag }
+                , m_chars{}
+            {
+                for(size_t i = 0; i < N; ++i)
+                {
+                    m_chars[i] = static_cast<utf16char>(str[i]);
+                }
+            }
+
+            // ASCII only.
+            constexpr StringLiteral(const char (&str)[N]) noexcept
+                : m_buffer{ 1, 0, static_cast<int>(N - 1), String::Buffer::StaticFlag }
+                , m_chars{}
+            {
+                for(size_t i = 0; i < N; ++i)
+                {
+                    m_chars[i] = static_cast<utf16char>(str[i]);
+                }
+            }
+        };
+
+        template <size_t N>
+        constexpr String::String(StringLiteral<N> &literal, std::true_type isInline) noexcept
+            : m_inline{}
+            , m_length(static_cast<int>(N - 1))
+        {
+            for(size_t i = 0; i < N; ++i)
+            {
+                m_inline[i] = literal.m_chars[i];
+            }
+        }
+
+        template <size_t N>
+        constexpr String::String(StringLiteral<N> &literal, std::false_type isInline) noexcept
+            : m_buffer(&literal.m_buffer)
+            , m_length(static_cast<int>(N - 1))
+        {
+            static_assert(offsetof(StringLiteral<N>, m_chars) == sizeof(Buffer), "The characters must follow the buffer header.");
+        }
+
         bool operator==(const String &str1, const String &str2);
         bool operator==(const char *str1, const String &str2);
         bool operator==(const String &str1, const char *str2);
         bool operator==(const utf16char *str1, const String &str2);
         bool operator==(const String &str1, const utf16char *str2);
+        // Orders strings ordinally, for sorted containers.
+        bool operator<(const String &str1, const String &str2);
+
+        namespace Internal
+        {
+            // Enough characters for any 64-bit integer and the shortest form of any double.
+            static constexpr int NumberBufferLength = 32;
+
+            // Formats a number into destination the way ToString does and returns the number of characters written.
+            // Floating point numbers are written in their shortest round-trip form.
+            int FormatNumber(const int64_t value, char *destination) noexcept;
+            int FormatNumber(const uint64_t value, char *destination) noexcept;
+            int FormatNumber(const float value, char *destination) noexcept;
+            int FormatNumber(const double value, char *destination) noexcept;
+
+            // Adapts an argument of String::Concat and String::Join: the length is known on construction, CopyTo
+            // writes the characters and returns the position after them. IsLatin1 tells whether the characters all
+            // fit a byte, so that they can also be written to a Latin-1 string. Types without a specialization can't
+            // be concatenated.
+            template <typename T, typename = void>
+            struct StringPart;
+
+            template <>
+            struct StringPart<String>
+            {
+                const String &m_value;
+
+                inline StringPart(const String &value) noexcept : m_value(value) {}
+                inline int Length() const noexcept { return m_value.Length(); }
+                inline bool IsLatin1() const noexcept
+                {
+                    return m_value.IsLatin1() || Text::Latin1Utility::GetIndexOfFirstNonLatin1Char(m_value.GetUtf16Chars(), m_value.Length()) == static_cast<size_t>(m_value.Length());
+                }
+                inline utf16char* CopyTo(utf16char *destination) const noexcept
+                {
+                    m_value.CopyTo(destination);
+
+                    return destination + m_value.Length();
+                }
+                inline char* CopyTo(char *destination) const noexcept
+                {
+                    if(m_value.IsLatin1())
+                    {
+                        memcpy(destination, m_value.GetLatin1Chars(), m_value.Length());
+                    }
+                    else
+                    {
+                        Text::Latin1Utility::NarrowUtf16ToLatin1(m_value.GetUtf16Chars(), destination, m_value.Length());
+                    }
+
+                    return destination + m_value.Length();
+                }
+            };
+
+            template <>
+            struct StringPart<const char*>
+            {
+                const char *m_value;
+                int         m_length;
+
+                inline StringPart(const char *value) noexcept : m_value(value), m_length(value ? static_cast<int>(strlen(value)) : 0) {}
+                inline int Length() const noexcept { return m_length; }
+                inline bool IsLatin1() const noexcept { return true; }
+                inline utf16char* CopyTo(utf16char *destination) const noexcept
+                {
+                    Text::Latin1Utility::WidenLatin1ToUtf16(m_value, destination, m_length);
+
+                    return destination + m_length;
+                }
+                inline char* CopyTo(char *destination) const noexcept
+                {
+                    if(m_length > 0)
+                    {
+                        memcpy(destination, m_value, m_length);
+                    }
+
+                    return destination + m_length;
+                }
+            };
+
+            template <>
+            struct StringPart<char*> : StringPart<const char*>
+            {
+                using StringPart<const char*>::StringPart;
+            };
+
+            template <>
+            struct StringPart<const utf16char*>
+            {
+                const utf16char *m_value;
+                int              m_length;
+
+                inline StringPart(const utf16char *value) noexcept : m_value(value), m_length(static_cast<int>(utf16len(value))) {}
+                inline int Length() const noexcept { return m_length; }
+                inline bool IsLatin1() const noexcept { return Text::Latin1Utility::GetIndexOfFirstNonLatin1Char(m_value, m_length) == static_cast<size_t>(m_length); }
+                inline utf16char* CopyTo(utf16char *destination) const noexcept
+                {
+                    memcpy(destination, m_value, sizeof(utf16char) * m_length);
+
+                    return destination + m_length;
+                }
+                inline char* CopyTo(char *destination) const noexcept
+                {
+                    Text::Latin1Utility::NarrowUtf16ToLatin1(m_value, destination, m_length);
+
+                    return destination + m_length;
+                }
+            };
+
+            template <>
+            struct StringPart<utf16char*> : StringPart<const utf16char*>
+            {
+                using StringPart<const utf16char*>::StringPart;
+            };
+
+            // utf16char is an unsigned short, so unsigned shorts are appended as characters rather than numbers.
+            template <>
+            struct StringPart<utf16char>
+            {
+                utf16char m_value;
+
+                inline StringPart(const utf16char value) noexcept : m_value(value) {}
+                inline int Length() const noexcept { return 1; }
+                inline bool IsLatin1() const noexcept { return m_value <= 0xff; }
+                inline utf16char* CopyTo(utf16char *destination) const noexcept
+                {
+                    *destination = m_value;
+
+                    return destination + 1;
+                }
+                inline char* CopyTo(char *destination) const noexcept
+                {
+                    *destination = static_cast<char>(m_value);
+
+                    return destination + 1;
+                }
+            };
+
+            template <>
+            struct StringPart<char> : StringPart<utf16char>
+            {
+                inline StringPart(const char value) noexcept : StringPart<utf16char>(static_cast<unsigned char>(value)) {}
+            };
+
+            template <>
+            struct StringPart<bool> : StringPart<const char*>
+            {
+                inline StringPart(const bool value) noexcept : StringPart<const char*>(value ? "True" : "False") {}
+            };
+
+            // Numbers are formatted into the part on construction.
+            template <typename T>
+            struct StringPart<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+            {
+                char m_chars[NumberBufferLength];
+                int  m_length;
+
+                inline StringPart(const T value) noexcept
+                {
+                    if constexpr(std::is_same<T, float>::value)
+                    {
+                        m_length = FormatNumber(value, m_chars);
+                    }
+                    else if constexpr(std::is_floating_point<T>::value)
+                    {
+                        m_length = FormatNumber(static_cast<double>(value), m_chars);
+                    }
+                    else if constexpr(std::is_signed<T>::value)
+                    {
+                        m_length = FormatNumber(static_cast<int64_t>(value), m_chars);
+                    }
+                    else
+                    {
+                        m_length = FormatNumber(static_cast<uint64_t>(value), m_chars);
+                    }
+                }
+
+                inline int Length() const noexcept { return m_length; }
+                inline bool IsLatin1() const noexcept { return true; }
+                inline utf16char* CopyTo(utf16char *destination) const noexcept
+                {
+                    Text::Latin1Utility::WidenLatin1ToUtf16(m_chars, destination, m_length);
+
+                    return destination + m_length;
+                }
+                inline char* CopyTo(char *destination) const noexcept
+                {
+                    memcpy(destination, m_chars, m_length);
+
+                    return destination + m_length;
+                }
+            };
+
+            // String literals and char arrays are passed as arrays.
+            template <typename T>
+            using StringPartOf = StringPart<typename std::decay<T>::type>;
+
+            inline int CheckStringLength(const int64_t length)
+            {
+                if(length > INT_MAX)
+                {
+                    throw std::bad_alloc();
+                }
+
+                return static_cast<int>(length);
+            }
+
+            // Writes the values of a non-empty range with the separator between them.
+            template <typename TChar, typename TSeparatorPart, typename TIterator>
+            inline void WriteJoined(TChar *destination, const TSeparatorPart &separatorPart, TIterator first, const TIterator last) noexcept
+            {
+                typedef StringPartOf<decltype(*first)> ValuePart;
+
+                destination = ValuePart(*first).CopyTo(destination);
+
+                while(++first != last)
+                {
+                    destination = separatorPart.CopyTo(destination);
+                    destination = ValuePart(*first).CopyTo(destination);
+                }
+            }
+        }
+
+        template <typename... TArgs>
+        String String::Concat(const TArgs&... args)
+        {
+            return ConcatParts(Internal::StringPartOf<TArgs>(args)...);
+        }
+
+        template <typename... TParts>
+        String String::ConcatParts(const TParts&... parts)
+        {
+            const int length = Internal::CheckStringLength((static_cast<int64_t>(0) + ... + parts.Length()));
+
+            if(length > InlineCapacity && (... && parts.IsLatin1()))
+            {
+                String str = FastAllocateLatin1String(length);
+                char *destination = str.GetMutableLatin1Chars();
+
+                ((destination = parts.CopyTo(destination)), ...);
+
+                return str;
+            }
+
+            String str = FastAllocateString(length);
+            utf16char *destination = str.GetMutableChars();
+
+            ((destination = parts.CopyTo(destination)), ...);
+
+            return str;
+        }
+
+        template <typename TSeparator, typename TIterator>
+        String String::Join(const TSeparator &separator, TIterator first, const TIterator last)
+        {
+            typedef Internal::StringPartOf<decltype(*first)> ValuePart;
+
+            if(first == last)
+            {
+                return String();
+            }
+
+            const Internal::StringPartOf<TSeparator> separatorPart(separator);
+            int64_t length = -separatorPart.Length();
+            bool isLatin1 = separatorPart.IsLatin1();
+
+            for(TIterator it = first; it != last; ++it)
+            {
+                const ValuePart part(*it);
+
+                length += separatorPart.Length() + part.Length();
+                isLatin1 = isLatin1 && part.IsLatin1();
+            }
+
+            String str;
+
+            if(length > InlineCapacity && isLatin1)
+            {
+                str = FastAllocateLatin1String(Internal::CheckStringLength(length));
+                Internal::WriteJoined(str.GetMutableLatin1Chars(), separatorPart, first, last);
+            }
+            else
+            {
+                str = FastAllocateString(Internal::CheckStringLength(length));
+                Internal::WriteJoined(str.GetMutableChars(), separatorPart, first, last);
+            }
+
+            return str;
+        }
+
+        template <typename TSeparator, typename TRange>
+        String String::Join(const TSeparator &separator, const TRange &values)
+        {
+            return Join(separator, std::begin(values), std::end(values));
+        }
     }
 }
 
@@ -1,5 +1,7 @@
 #include "StringBuilder.h"
 #include "Exception.h"
+#include "StringSegment.h"
+#include "Text/Latin1Utility.h"
 
 #include <cassert>
 #include <algorithm>
@@ -26,16 +28,14 @@ namespace DotNetNative
             {
                 m_blocks = DNN_make_unique(Block);
                 m_blocks->m_nextBlock = nullptr;
-                m_blocks->m_characters = DNN_make_unique_array(utf16char[], str.Length());
+                m_blocks->m_characters = AllocateCharacters(str.Length());
                 m_blocks->m_blockLength = str.Length();
                 m_blocks->m_offset = 0;
                 m_blocks->m_count = str.Length();
 
                 m_currentBlock = m_blocks.get();
 
-                const size_t copySize = sizeof(utf16char) * str.Length();
-
-                memcpy_s(m_blocks->m_characters.get(), copySize, str.m_string.get(), copySize);
+                str.CopyTo(m_blocks->m_characters.get());
             }
         }
 
@@ -58,7 +58,7 @@ namespace DotNetNative
             {
                 m_blocks = DNN_make_unique(Block);
                 m_blocks->m_nextBlock = nullptr;
-                m_blocks->m_characters = DNN_make_unique_array(utf16char[], length);
+                m_blocks->m_characters = AllocateCharacters(length);
                 m_blocks->m_blockLength = length;
                 m_blocks->m_offset = 0;
                 m_blocks->m_count = length;
@@ -90,17 +90,14 @@ namespace DotNetNative
             {
                 m_blocks = DNN_make_unique(Block);
                 m_blocks->m_nextBlock = nullptr;
-                m_blocks->m_characters = DNN_make_unique_array(utf16char[], length);
+                m_blocks->m_characters = AllocateCharacters(length);
                 m_blocks->m_blockLength = length;
                 m_blocks->m_offset = 0;
                 m_blocks->m_count = length;
 
                 m_currentBlock = m_blocks.get();
 
-                for(int i = 0; i < length; ++i)
-                {
-                    m_blocks->m_characters.get()[i] = static_cast<utf16char>(str[i]);
-                }
+                Text::Latin1Utility::WidenLatin1ToUtf16(str, m_blocks->m_characters.get(), length);
             }
         }
 
@@ -118,7 +115,7 @@ namespace DotNetNative
             {
                 m_blocks = DNN_make_unique(Block);
                 m_blocks->m_nextBlock = nullptr;
-                m_blocks->m_characters = DNN_make_unique_array(utf16char[], capacity);
+                m_blocks->m_characters = AllocateCharacters(capacity);
                 m_blocks->m_blockLength = capacity;
                 m_blocks->m_offset = 0;
                 m_blocks->m_count = 0;
@@ -137,7 +134,7 @@ namespace DotNetNative
             {
                 m_blocks = DNN_make_unique(Block);
                 m_blocks->m_nextBlock = nullptr;
-                m_blocks->m_characters = DNN_make_unique_array(utf16char[], copy.m_length);
+                m_blocks->m_characters = AllocateCharacters(copy.m_length);
                 m_blocks->m_blockLength = copy.m_length;
                 m_blocks->m_offset = 0;
                 m_blocks->m_count = copy.m_length;
@@ -174,7 +171,7 @@ namespace DotNetNative
                 {
                     m_blocks = DNN_make_unique(Block);
                     m_blocks->m_nextBlock = nullptr;
-                    m_blocks->m_characters = DNN_make_unique_array(utf16char[], copy.m_length);
+                    m_blocks->m_characters = AllocateCharacters(copy.m_length);
                     m_blocks->m_blockLength = copy.m_length;
                     m_blocks->m_offset = 0;
                     m_blocks->m_count = copy.m_length;
@@ -260,7 +257,7 @@ namespace DotNetNative
             }
 
             // Assume the string is going to be modified and clear the cached string
-            m_string.reset();
+            m_string = String();
 
             int curLength = 0;
 
@@ -279,16 +276,17 @@ namespace DotNetNative
 
         String StringBuilder::ToString()
         {
-            if(!m_string && m_length > 0)
+            // The cached string is dropped on every change, so it is current when the lengths match.
+            if(m_string.Length() != m_length)
             {
-                m_string = shared_ptr<utf16char[]>(DNN_New utf16char[static_cast<size_t>(m_length) + 1], Deleter<utf16char[]>(), DNN_Allocator(utf16char[]));
+                String str = String::FastAllocateString(m_length);
+
+                CopyBlocks(str.GetMutableChars(), m_length, *this);
 
-                CopyBlocks(m_string.get(), m_length, *this);
-                
-                m_string.get()[m_length] = 0;
+                m_string = std::move(str);
             }
 
-            return String(m_string, m_length);
+            return m_string;
         }
 
         String StringBuilder::ToString(const int startIndex, const int length) const
@@ -298,10 +296,11 @@ namespace DotNetNative
                 throw ArgumentOutOfRangeException();
             }
 
-            shared_ptr<utf16char[]> str;
+            String str = String::FastAllocateString(length);
 
             if(length > 0)
             {
+                utf16char *chars = str.GetMutableChars();
                 int totalStartLength = 0;
                 Block *blockIter;
 
@@ -323,17 +322,16 @@ namespace DotNetNative
 
                 const int startBlockOffset = startIndex - totalStartLength;
                 const size_t destSize = sizeof(utf16char) * length;
-                str = shared_ptr<utf16char[]>(DNN_New utf16char[static_cast<size_t>(length) + 1], Deleter<utf16char[]>(), DNN_Allocator(utf16char[]));
 
                 if(startBlockOffset + length <= blockIter->m_count)
                 {
-                    memcpy_s(str.get(), destSize, blockIter->m_characters.get() + blockIter->m_offset, destSize);
+                    memcpy_s(chars, destSize, blockIter->m_characters.get() + blockIter->m_offset + startBlockOffset, destSize);
                 }
                 else
                 {
                     int numChars = blockIter->m_count - startBlockOffset;
 
-                    memcpy_s(str.get(), destSize, blockIter->m_characters.get(), sizeof(utf16char) * numChars);
+                    memcpy_s(chars, destSize, blockIter->m_characters.get() + blockIter->m_offset + startBlockOffset, sizeof(utf16char) * numChars);
 
                     while(blockIter = blockIter->m_nextBlock.get())
                     {
@@ -346,24 +344,21 @@ namespace DotNetNative
                                 throw InvalidOperationException("Unexpected error when flattening string builder blocks.");
                             }
 
-                            memcpy_s(str.get() + numChars, destSize - (sizeof(utf16char) * numChars), blockIter->m_characters.get() + blockIter->m_offset, remaining * sizeof(utf16char));
+                            memcpy_s(chars + numChars, destSize - (sizeof(utf16char) * numChars), blockIter->m_characters.get() + blockIter->m_offset, remaining * sizeof(utf16char));
 
                             break;
                         }
 
-                        memcpy_s(str.get() + numChars, destSize - (sizeof(utf16char) * numChars), blockIter->m_characters.get() + blockIter->m_offset, blockIter->m_count * sizeof(utf16char));
+                        memcpy_s(chars + numChars, destSize - (sizeof(utf16char) * numChars), blockIter->m_characters.get() + blockIter->m_offset, blockIter->m_count * sizeof(utf16char));
 
                         numChars += blockIter->m_count;
 
                         assert(blockIter != m_currentBlock);
                     }
                 }
-
-                str.get()[length] = 0;
-
             }
 
-            return String(std::move(str), length);
+            return str;
         }
 
         int StringBuilder::EnsureCapacity(int capacity)
@@ -424,7 +419,7 @@ namespace DotNetNative
             }
 
             m_length -= length;
-            m_string.reset();
+            m_string = String();
 
             Block *blockIter;
             int charOffset = 0;
@@ -504,7 +499,7 @@ namespace DotNetNative
         {
             EnsureCapacity(m_capacity + 1);
 
-            m_string.reset();
+            m_string = String();
             ++m_length;
 
             if(m_currentBlock->m_offset + m_currentBlock->m_count + 1 > m_currentBlock->m_blockLength)
@@ -536,7 +531,7 @@ namespace DotNetNative
 
         StringBuilder& StringBuilder::Append(const char value)
         {
-            return Append(static_cast<utf16char>(value));
+            return Append(static_cast<utf16char>(static_cast<uint8_t>(value)));
         }
 
         StringBuilder& StringBuilder::Append(const utf16char value, int repeatCount)
@@ -548,7 +543,7 @@ namespace DotNetNative
 
             EnsureCapacity(m_capacity + repeatCount);
 
-            m_string.reset();
+            m_string = String();
             m_length += repeatCount;
 
             if(m_currentBlock->m_offset + m_currentBlock->m_count >= m_currentBlock->m_blockLength)
@@ -627,7 +622,7 @@ namespace DotNetNative
 
             EnsureCapacity(m_capacity + length);
 
-            m_string.reset();
+            m_string = String();
             m_length += length;
 
             if(m_currentBlock->m_offset + m_currentBlock->m_count >= m_currentBlock->m_blockLength)
@@ -703,7 +698,7 @@ namespace DotNetNative
 
             EnsureCapacity(m_capacity + length);
 
-            m_string.reset();
+            m_string = String();
             m_length += length;
 
             if(m_currentBlock->m_offset + m_currentBlock->m_count >= m_currentBlock->m_blockLength)
@@ -731,10 +726,7 @@ namespace DotNetNative
                 const int iterCount = std::min(available, length);
                 utf16char *destPtr = m_currentBlock->m_characters.get() + m_currentBlock->m_offset + m_currentBlock->m_count;
 
-                for(int i = 0; i < iterCount; ++i)
-                {
-                    destPtr[i] = static_cast<utf16char>(value[i]);
-                }
+                Text::Latin1Utility::WidenLatin1ToUtf16(value, destPtr, iterCount);
 
                 m_currentBlock->m_count += iterCount;
                 length -= iterCount;
@@ -766,7 +758,24 @@ namespace DotNetNative
         {
             if(value.Length() > 0)
             {
-                Append(value.m_string.get(), value.m_length);
+                if(value.IsLatin1())
+                {
+                    Append(value.GetLatin1Chars(), value.m_length);
+                }
+                else
+                {
+                    Append(value.GetUtf16Chars(), value.m_length);
+                }
+            }
+
+            return *this;
+        }
+
+        StringBuilder& StringBuilder::Append(const StringSegment &value)
+        {
+            if(value.Length() > 0)
+            {
+                Append(value.Data(), value.Length());
             }
 
             return *this;
@@ -781,7 +790,7 @@ namespace DotNetNative
 
             EnsureCapacity(m_capacity + value.GetLength());
 
-            m_string.reset();
+            m_string = String();
             m_length += value.GetLength();
 
             if(m_currentBlock->m_offset + m_currentBlock->m_count >= m_currentBlock->m_blockLength)
@@ -895,7 +904,7 @@ namespace DotNetNative
                 throw ArgumentOutOfRangeException("length must be less than the length of the StringBuilder.");
             }
 
-            m_string.reset();
+            m_string = String();
 
             if(length == m_length)
             {
@@ -976,11 +985,24 @@ namespace DotNetNative
             assert(destOffset == destSize);
         }
 
+        sized_unique_ptr<utf16char[]> StringBuilder::AllocateCharacters(const int capacity)
+        {
+            const size_t size = sizeof(utf16char) * capacity;
+            utf16char *characters = static_cast<utf16char*>(DNN_Alloc(size));
+
+            if(!characters && size > 0)
+            {
+                throw std::bad_alloc();
+            }
+
+            return sized_unique_ptr<utf16char[]>(characters, SizedFreeDeleter<utf16char[]>{ size });
+        }
+
         unique_ptr<StringBuilder::Block> StringBuilder::AllocateBlock(const int capacity)
         {
             unique_ptr<Block> block = DNN_make_unique(Block);
             block->m_nextBlock = nullptr;
-            block->m_characters = DNN_make_unique_array(utf16char[], capacity);
+            block->m_characters = AllocateCharacters(capacity);
             block->m_blockLength = capacity;
             block->m_offset = 0;
             block->m_count = 0;
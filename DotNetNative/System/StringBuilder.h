@@ -12,22 +12,23 @@ namespace DotNetNative
         private:
             struct Block
             {
-                unique_ptr<Block>       m_nextBlock;
-                unique_ptr<utf16char[]> m_characters;
-                int                     m_blockLength;
-                int                     m_offset;
-                int                     m_count;
+                unique_ptr<Block>             m_nextBlock;
+                sized_unique_ptr<utf16char[]> m_characters;
+                int                           m_blockLength;
+                int                           m_offset;
+                int                           m_count;
             };
 
         private:
             unique_ptr<Block>       m_blocks;
             Block                  *m_currentBlock;
-            shared_ptr<utf16char[]> m_string;
+            String                  m_string;
             int                     m_length;
             int                     m_capacity;
 
         private:
             static void CopyBlocks(utf16char *destination, const int destSize, const StringBuilder &src);
+            static sized_unique_ptr<utf16char[]> AllocateCharacters(const int capacity);
             static unique_ptr<Block> AllocateBlock(const int capacity);
 
         public:
@@ -59,6 +60,7 @@ namespace DotNetNative
             StringBuilder& Append(const utf16char *value, int length);
             StringBuilder& Append(const char *value, int length);
             StringBuilder& Append(const String &value);
+            StringBuilder& Append(const StringSegment &value);
             StringBuilder& Append(const StringBuilder &value);
 
             inline int Capacity() const noexcept { return m_capacity; }
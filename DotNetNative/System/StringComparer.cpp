@@ -0,0 +1,228 @@
+#include "StringComparer.h"
+#include "Char.h"
+#include "Globalization/InvariantCasing.h"
+#include "Text/Latin1Utility.h"
+
+#define XXH_STATIC_LINKING_ONLY
+#include "../xxhash.h"
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        using Globalization::InvariantCasing;
+
+        class StringComparer::OrdinalComparer final
+            : public StringComparer
+        {
+        public:
+            virtual bool Equals(const String &x, const String &y) const noexcept override
+            {
+                return x.Equals(y);
+            }
+
+            virtual int GetHashCode(const String &obj) const override
+            {
+                return obj.GetHashCode();
+            }
+        };
+
+        class StringComparer::OrdinalIgnoreCaseComparer final
+            : public StringComparer
+        {
+        private:
+            // Characters converted to upper case on the stack at a time to be hashed.
+            static constexpr int ChunkLength = 64;
+
+            // Passes the characters as String::ToUpperInvariant would convert them to update, a chunk at a time.
+            // The characters before 'first' don't change and are passed in place.
+            template <typename TUpdate>
+            static void ForEachUpperChunk(const utf16char *chars, const int first, const int length, TUpdate update) noexcept
+            {
+                utf16char upper[ChunkLength];
+
+                update(chars, first);
+
+                for(int i = first; i < length;)
+                {
+                    int count = length - i < ChunkLength ? length - i : ChunkLength;
+
+                    // Keep surrogate pairs in one chunk, the conversion leaves unpaired surrogates alone.
+                    if(i + count < length && Char::IsHighSurrogate(chars[i + count - 1]))
+                    {
+                        --count;
+                    }
+
+                    InvariantCasing::ToUpper(chars + i, upper, count);
+                    update(upper, count);
+                    i += count;
+                }
+            }
+
+            // The same for a Latin-1 string, widened a chunk at a time.
+            template <typename TUpdate>
+            static void ForEachUpperChunk(const char *chars, const int length, TUpdate update) noexcept
+            {
+                utf16char upper[ChunkLength];
+
+                for(int i = 0; i < length; i += ChunkLength)
+                {
+                    const int count = length - i < ChunkLength ? length - i : ChunkLength;
+
+                    Text::Latin1Utility::WidenLatin1ToUtf16(chars + i, upper, count);
+                    InvariantCasing::ToUpper(upper, upper, count);
+                    update(upper, count);
+                }
+            }
+
+            static bool EqualsIgnoreCase(const utf16char *chars1, const utf16char *chars2, const int length) noexcept
+            {
+                return InvariantCasing::EqualsIgnoreCase(chars1, chars2, length);
+            }
+
+            // Latin-1 characters are widened on the stack a chunk at a time. A chunk may split a surrogate pair of the
+            // other string, which can't be equal to Latin-1 characters either way.
+            template <typename TChars1, typename TChars2>
+            static bool EqualsIgnoreCase(const TChars1 *chars1, const TChars2 *chars2, const int length) noexcept
+            {
+                utf16char wide1[ChunkLength];
+                utf16char wide2[ChunkLength];
+
+                for(int i = 0; i < length; i += ChunkLength)
+                {
+                    const int count = length - i < ChunkLength ? length - i : ChunkLength;
+
+                    if(!InvariantCasing::EqualsIgnoreCase(Widen(chars1 + i, wide1, count), Widen(chars2 + i, wide2, count), count))
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            static inline const utf16char* Widen(const utf16char *chars, utf16char *buffer, const int count) noexcept
+            {
+                return chars;
+            }
+
+            static inline const utf16char* Widen(const char *chars, utf16char *buffer, const int count) noexcept
+            {
+                Text::Latin1Utility::WidenLatin1ToUtf16(chars, buffer, count);
+
+                return buffer;
+            }
+
+            static int GetLatin1HashCode(const char *chars, const int length) noexcept
+            {
+                if(sizeof(void*) >= 8)
+                {
+                    XXH64_state_t state;
+
+                    XXH64_reset(&state, 0);
+                    ForEachUpperChunk(chars, length, [&state](const utf16char *part, const int count) { XXH64_update(&state, part, sizeof(utf16char) * count); });
+
+                    const XXH64_hash_t hash = XXH64_digest(&state);
+
+                    return static_cast<int>(hash ^ (hash >> 32));
+                }
+
+                XXH32_state_t state;
+
+                XXH32_reset(&state, 0);
+                ForEachUpperChunk(chars, length, [&state](const utf16char *part, const int count) { XXH32_update(&state, part, sizeof(utf16char) * count); });
+
+                return static_cast<int>(XXH32_digest(&state));
+            }
+
+        public:
+            virtual bool Equals(const String &x, const String &y) const noexcept override
+            {
+                if(x.m_atomId != 0 && x.m_atomId == y.m_atomId)
+                {
+                    return true;
+                }
+
+                if(x.m_length != y.m_length)
+                {
+                    return false;
+                }
+
+                if(!x.IsInline() && x.m_buffer == y.m_buffer)
+                {
+                    return true;
+                }
+
+                return x.VisitChars([&x, &y](const auto *chars1)
+                {
+                    return y.VisitChars([&x, chars1](const auto *chars2) { return EqualsIgnoreCase(chars1, chars2, x.m_length); });
+                });
+            }
+
+            // The hash code of the string converted to upper case, computed without converting it.
+            virtual int GetHashCode(const String &obj) const override
+            {
+                if(obj.IsLatin1())
+                {
+                    return GetLatin1HashCode(obj.GetLatin1Chars(), obj.m_length);
+                }
+
+                const utf16char *chars = obj.GetUtf16Chars();
+                const int length = obj.m_length;
+                const int first = InvariantCasing::IndexOfFirstCharToUpper(chars, length);
+
+                // The string is its own upper case and may have its hash code cached.
+                if(first < 0)
+                {
+                    return obj.GetHashCode();
+                }
+
+                if(length <= ChunkLength)
+                {
+                    utf16char upper[ChunkLength];
+
+                    InvariantCasing::ToUpper(chars, upper, length);
+
+                    return String::ComputeHashCode(upper, length);
+                }
+
+                if(sizeof(void*) >= 8)
+                {
+                    XXH64_state_t state;
+
+                    XXH64_reset(&state, 0);
+                    ForEachUpperChunk(chars, first, length, [&state](const utf16char *part, const int count) { XXH64_update(&state, part, sizeof(utf16char) * count); });
+
+                    const XXH64_hash_t hash = XXH64_digest(&state);
+
+                    return static_cast<int>(hash ^ (hash >> 32));
+                }
+
+                XXH32_state_t state;
+
+                XXH32_reset(&state, 0);
+                ForEachUpperChunk(chars, first, length, [&state](const utf16char *part, const int count) { XXH32_update(&state, part, sizeof(utf16char) * count); });
+
+                return static_cast<int>(XXH32_digest(&state));
+            }
+        };
+
+        // The comparers are statics shared without ownership, so that handing them out never allocates and they
+        // outlive any arena or allocator scope current at first use.
+        const shared_ptr<StringComparer>& StringComparer::Ordinal() noexcept
+        {
+            static OrdinalComparer comparer;
+            static const shared_ptr<StringComparer> instance(shared_ptr<StringComparer>(), &comparer);
+
+            return instance;
+        }
+
+        const shared_ptr<StringComparer>& StringComparer::OrdinalIgnoreCase() noexcept
+        {
+            static OrdinalIgnoreCaseComparer comparer;
+            static const shared_ptr<StringComparer> instance(shared_ptr<StringComparer>(), &comparer);
+
+            return instance;
+        }
+    }
+}
\ No newline at end of file
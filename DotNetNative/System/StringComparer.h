@@ -0,0 +1,46 @@
+#ifndef _DOTNETNATIVE_SYSTEM_STRINGCOMPARER_H_
+#define _DOTNETNATIVE_SYSTEM_STRINGCOMPARER_H_
+
+#include "String.h"
+#include "Collections/EqualityComparer.h"
+#include "../MemoryUtil.h"
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        // Equality comparers for string keys, for example Dictionary<String, TValue>(StringComparer::OrdinalIgnoreCase()).
+        // Neither comparer allocates to compare or hash a string.
+        class StringComparer
+            : public virtual Collections::EqualityComparer<String>
+        {
+        private:
+            class OrdinalComparer;
+            class OrdinalIgnoreCaseComparer;
+
+        protected:
+            StringComparer() = default;
+            StringComparer(const StringComparer &copy) = default;
+            StringComparer(StringComparer &&mov) noexcept = default;
+
+        public:
+            virtual ~StringComparer() {}
+
+            virtual bool Equals(const String &x, const String &y) const noexcept override = 0;
+            virtual int GetHashCode(const String &obj) const override = 0;
+
+            //
+            // Summary:
+            //     Gets a comparer that compares the UTF-16 code units of the strings.
+            static const shared_ptr<StringComparer>& Ordinal() noexcept;
+
+            //
+            // Summary:
+            //     Gets a comparer that compares the UTF-16 code units of the strings after mapping them to upper case
+            //     with the invariant culture's simple case mappings, as String::ToUpperInvariant does.
+            static const shared_ptr<StringComparer>& OrdinalIgnoreCase() noexcept;
+        };
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "StringSegment.h"
+#include "SpanHelpers.h"
+#include "StringSplitEnumerator.h"
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        StringSegment::StringSegment() noexcept
+            : m_chars(nullptr)
+            , m_offset(0)
+            , m_length(0)
+        {
+        }
+
+        StringSegment::StringSegment(const String &str)
+            : m_string(str)
+            , m_chars(nullptr)
+            , m_offset(0)
+            , m_length(str.Length())
+        {
+            // Segments are read as UTF-16, so the characters of a Latin-1 string are widened once for all its segments.
+            m_string.GetChars();
+        }
+
+        StringSegment::StringSegment(const String &str, const int offset, const int length)
+            : m_chars(nullptr)
+            , m_offset(offset)
+            , m_length(length)
+        {
+            if(offset < 0 || length < 0 || offset > str.Length() - length)
+            {
+                throw ArgumentOutOfRangeException();
+            }
+
+            m_string = str;
+            m_string.GetChars();
+        }
+
+        StringSegment::StringSegment(const utf16char *chars, const int length)
+            : m_chars(chars)
+            , m_offset(0)
+            , m_length(length)
+        {
+            if(length < 0)
+            {
+                throw ArgumentOutOfRangeException("length");
+            }
+
+            if(!chars && length > 0)
+            {
+                throw ArgumentNullException("chars");
+            }
+        }
+
+        utf16char StringSegment::operator[](const int index) const
+        {
+            if(index < 0 || index >= m_length)
+            {
+                throw IndexOutOfRangeException();
+            }
+
+            return Data()[index];
+        }
+
+        StringSegment StringSegment::Subsegment(const int offset) const
+        {
+            return Subsegment(offset, m_length - offset);
+        }
+
+        StringSegment StringSegment::Subsegment(const int offset, const int length) const
+        {
+            if(offset < 0 || length < 0 || offset > m_length - length)
+            {
+                throw ArgumentOutOfRangeException();
+            }
+
+            StringSegment segment(*this);
+
+            segment.m_offset += offset;
+            segment.m_length = length;
+
+            return segment;
+        }
+
+        StringSegment StringSegment::Trim() const
+        {
+            const int leading = SpanHelpers::CountLeadingWhiteSpace(Data(), m_length);
+
+            return Subsegment(leading, m_length - leading - SpanHelpers::CountTrailingWhiteSpace(Data() + leading, m_length - leading));
+        }
+
+        StringSegment StringSegment::TrimStart() const
+        {
+            return Subsegment(SpanHelpers::CountLeadingWhiteSpace(Data(), m_length));
+        }
+
+        StringSegment StringSegment::TrimEnd() const
+        {
+            return Subsegment(0, m_length - SpanHelpers::CountTrailingWhiteSpace(Data(), m_length));
+        }
+
+        bool StringSegment::Equals(const StringSegment &other) const noexcept
+        {
+            return m_length == other.m_length && SpanHelpers::SequenceEqual(Data(), other.Data(), m_length);
+        }
+
+        bool StringSegment::Equals(const String &other) const noexcept
+        {
+            return m_length == other.Length() && other.VisitChars([this](const auto *chars) { return SpanHelpers::SequenceEqual(Data(), chars, m_length); });
+        }
+
+        int StringSegment::GetHashCode() const
+        {
+            // A segment of a whole String uses the hash code the String caches.
+            if(!m_chars && m_length == m_string.Length())
+            {
+                return m_string.GetHashCode();
+            }
+
+            return String::ComputeHashCode(Data(), m_length);
+        }
+
+        String StringSegment::ToString() const
+        {
+            if(!m_chars && m_length == m_string.Length())
+            {
+                return m_string;
+            }
+
+            return String(Data(), m_length);
+        }
+
+        int StringSegment::IndexOf(const utf16char value) const noexcept
+        {
+            return SpanHelpers::IndexOf(Data(), m_length, value);
+        }
+
+        int StringSegment::IndexOf(const utf16char value, const int startIndex) const
+        {
+            if(startIndex < 0 || startIndex > m_length)
+            {
+                throw ArgumentOutOfRangeException("startIndex");
+            }
+
+            const int index = SpanHelpers::IndexOf(Data() + startIndex, m_length - startIndex, value);
+
+            return index < 0 ? -1 : index + startIndex;
+        }
+
+        int StringSegment::IndexOf(const StringSegment &value) const noexcept
+        {
+            return SpanHelpers::IndexOf(Data(), m_length, value.Data(), value.m_length);
+        }
+
+        int StringSegment::IndexOfAny(const utf16char *anyOf, const int count) const
+        {
+            if(count < 0)
+            {
+                throw ArgumentOutOfRangeException("count");
+            }
+
+            if(!anyOf && count > 0)
+            {
+                throw ArgumentNullException("anyOf");
+            }
+
+            return SpanHelpers::IndexOfAny(Data(), m_length, anyOf, count);
+        }
+
+        int StringSegment::LastIndexOf(const utf16char value) const noexcept
+        {
+            return SpanHelpers::LastIndexOf(Data(), m_length, value);
+        }
+
+        int StringSegment::LastIndexOf(const StringSegment &value) const noexcept
+        {
+            return SpanHelpers::LastIndexOf(Data(), m_length, value.Data(), value.m_length);
+        }
+
+        bool StringSegment::Contains(const utf16char value) const noexcept
+        {
+            return IndexOf(value) >= 0;
+        }
+
+        bool StringSegment::Contains(const StringSegment &value) const noexcept
+        {
+            return IndexOf(value) >= 0;
+        }
+
+        bool StringSegment::StartsWith(const StringSegment &value) const noexcept
+        {
+            return value.m_length <= m_length && SpanHelpers::SequenceEqual(Data(), value.Data(), value.m_length);
+        }
+
+        bool StringSegment::EndsWith(const StringSegment &value) const noexcept
+        {
+            return value.m_length <= m_length && SpanHelpers::SequenceEqual(Data() + m_length - value.m_length, value.Data(), value.m_length);
+        }
+
+        StringSplitEnumerator StringSegment::Split(const utf16char separator, const StringSplitOptions options) const
+        {
+            return StringSplitEnumerator(*this, separator, options);
+        }
+
+        StringSplitEnumerator StringSegment::Split(const utf16char *separators, const int count, const StringSplitOptions options) const
+        {
+            return StringSplitEnumerator(*this, separators, count, options);
+        }
+
+        StringSplitEnumerator StringSegment::Split(const String &separator, const StringSplitOptions options) const
+        {
+            return StringSplitEnumerator(*this, separator, options);
+        }
+
+        int StringSegment::CompareOrdinal(const StringSegment &a, const StringSegment &b) noexcept
+        {
+            return SpanHelpers::SequenceCompareTo(a.Data(), a.m_length, b.Data(), b.m_length);
+        }
+
+        bool operator==(const StringSegment &a, const StringSegment &b)
+        {
+            return a.Equals(b);
+        }
+
+        bool operator==(const StringSegment &a, const String &b)
+        {
+            return a.Equals(b);
+        }
+
+        bool operator==(const String &a, const StringSegment &b)
+        {
+            return b.Equals(a);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef _DOTNETNATIVE_SYSTEM_STRINGSEGMENT_H_
+#define _DOTNETNATIVE_SYSTEM_STRINGSEGMENT_H_
+
+#include "String.h"
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        class StringSplitEnumerator;
+
+        // A range of characters that is never copied. A segment of a String shares the String's buffer and keeps it
+        // alive, a segment made from a pointer borrows characters that must outlive it.
+        class StringSegment
+        {
+        private:
+            String           m_string;
+            const utf16char *m_chars;       // borrowed characters, or nullptr when m_string holds them
+            int              m_offset;
+            int              m_length;
+
+        public:
+            StringSegment() noexcept;
+            StringSegment(const String &str);
+            StringSegment(const String &str, const int offset, const int length);
+            StringSegment(const utf16char *chars, const int length);
+
+            inline const utf16char* Data() const noexcept { return (m_chars ? m_chars : static_cast<const utf16char*>(m_string)) + m_offset; }
+            inline int Offset() const noexcept { return m_offset; }
+            inline int Length() const noexcept { return m_length; }
+            inline bool IsEmpty() const noexcept { return m_length == 0; }
+
+            // The String the segment was taken from, empty for borrowed segments.
+            inline const String& Buffer() const noexcept { return m_string; }
+
+            utf16char operator[](const int index) const;
+
+            StringSegment Subsegment(const int offset) const;
+            StringSegment Subsegment(const int offset, const int length) const;
+
+            // The segment without leading and trailing (or only leading or trailing) white space.
+            StringSegment Trim() const;
+            StringSegment TrimStart() const;
+            StringSegment TrimEnd() const;
+
+            bool Equals(const StringSegment &other) const noexcept;
+            bool Equals(const String &other) const noexcept;
+
+            // Equal to the hash code of a String with the same characters.
+            int GetHashCode() const;
+
+            // Copies the characters into a String, or returns the String the segment covers entirely.
+            String ToString() const;
+
+            int IndexOf(const utf16char value) const noexcept;
+            int IndexOf(const utf16char value, const int startIndex) const;
+            int IndexOf(const StringSegment &value) const noexcept;
+            int IndexOfAny(const utf16char *anyOf, const int count) const;
+            int LastIndexOf(const utf16char value) const noexcept;
+            int LastIndexOf(const StringSegment &value) const noexcept;
+
+            bool Contains(const utf16char value) const noexcept;
+            bool Contains(const StringSegment &value) const noexcept;
+            bool StartsWith(const StringSegment &value) const noexcept;
+            bool EndsWith(const StringSegment &value) const noexcept;
+
+            StringSplitEnumerator Split(const utf16char separator, const StringSplitOptions options = StringSplitOptions::None) const;
+            StringSplitEnumerator Split(const utf16char *separators, const int count, const StringSplitOptions options = StringSplitOptions::None) const;
+            StringSplitEnumerator Split(const String &separator, const StringSplitOptions options = StringSplitOptions::None) const;
+
+            static int CompareOrdinal(const StringSegment &a, const StringSegment &b) noexcept;
+        };
+
+        bool operator==(const StringSegment &a, const StringSegment &b);
+        bool operator==(const StringSegment &a, const String &b);
+        bool operator==(const String &a, const StringSegment &b);
+
+        namespace Internal
+        {
+            template <>
+            struct StringPart<StringSegment>
+            {
+                const StringSegment &m_value;
+
+                inline StringPart(const StringSegment &value) noexcept : m_value(value) {}
+                inline int Length() const noexcept { return m_value.Length(); }
+                inline bool IsLatin1() const noexcept { return Text::Latin1Utility::GetIndexOfFirstNonLatin1Char(m_value.Data(), m_value.Length()) == static_cast<size_t>(m_value.Length()); }
+                inline utf16char* CopyTo(utf16char *destination) const noexcept
+                {
+                    memcpy(destination, m_value.Data(), sizeof(utf16char) * m_value.Length());
+
+                    return destination + m_value.Length();
+                }
+                inline char* CopyTo(char *destination) const noexcept
+                {
+                    Text::Latin1Utility::NarrowUtf16ToLatin1(m_value.Data(), destination, m_value.Length());
+
+                    return destination + m_value.Length();
+                }
+            };
+        }
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "StringSplitEnumerator.h"
+#include "SpanHelpers.h"
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        StringSplitEnumerator::StringSplitEnumerator(const StringSegment &source, const utf16char separator, const StringSplitOptions options)
+            : m_source(source)
+            , m_separator(separator)
+            , m_kind(SeparatorKind::Char)
+            , m_options(options)
+            , m_position(0)
+        {
+        }
+
+        StringSplitEnumerator::StringSplitEnumerator(const StringSegment &source, const utf16char *separators, const int count, const StringSplitOptions options)
+            : m_source(source)
+            , m_separator(0)
+            , m_kind(SeparatorKind::CharSet)
+            , m_options(options)
+            , m_position(0)
+        {
+            if(count < 0)
+            {
+                throw ArgumentOutOfRangeException("count");
+            }
+
+            if(count == 0)
+            {
+                m_kind = SeparatorKind::WhiteSpace;
+            }
+            else if(count == 1)
+            {
+                m_separator = separators[0];
+                m_kind = SeparatorKind::Char;
+            }
+            else
+            {
+                m_separators = StringSegment(String(separators, count));
+            }
+        }
+
+        StringSplitEnumerator::StringSplitEnumerator(const StringSegment &source, const String &separator, const StringSplitOptions options)
+            : m_source(source)
+            , m_separators(separator)
+            , m_separator(0)
+            , m_kind(separator.Length() > 0 ? SeparatorKind::String : SeparatorKind::None)
+            , m_options(options)
+            , m_position(0)
+        {
+        }
+
+        int StringSplitEnumerator::FindSeparator(const utf16char *chars, const int length, int &separatorLength) const noexcept
+        {
+            separatorLength = 1;
+
+            switch(m_kind)
+            {
+                case SeparatorKind::Char:
+                    return SpanHelpers::IndexOf(chars, length, m_separator);
+
+                case SeparatorKind::CharSet:
+                    return SpanHelpers::IndexOfAny(chars, length, m_separators.Data(), m_separators.Length());
+
+                case SeparatorKind::WhiteSpace:
+                    for(int i = 0; i < length; ++i)
+                    {
+                        if(Char::IsWhiteSpace(chars[i]))
+                        {
+                            return i;
+                        }
+                    }
+
+                    return -1;
+
+                case SeparatorKind::String:
+                    separatorLength = m_separators.Length();
+
+                    return SpanHelpers::IndexOf(chars, length, m_separators.Data(), m_separators.Length());
+
+                default:
+                    return -1;
+            }
+        }
+
+        const StringSegment& StringSplitEnumerator::Current() const &
+        {
+            return m_current;
+        }
+
+        StringSegment& StringSplitEnumerator::Current() &
+        {
+            return m_current;
+        }
+
+        bool StringSplitEnumerator::MoveNext()
+        {
+            const utf16char *source = m_source.Data();
+            const int sourceLength = m_source.Length();
+
+            while(m_position <= sourceLength)
+            {
+                int start = m_position;
+                int separatorLength;
+                int length = FindSeparator(source + start, sourceLength - start, separatorLength);
+
+                if(length < 0)
+                {
+                    length = sourceLength - start;
+                    m_position = sourceLength + 1;
+                }
+                else
+                {
+                    m_position += length + separatorLength;
+                }
+
+                if(m_options & StringSplitOptions::TrimEntries)
+                {
+                    const int leading = SpanHelpers::CountLeadingWhiteSpace(source + start, length);
+
+                    start += leading;
+                    length -= leading + SpanHelpers::CountTrailingWhiteSpace(source + start, length - leading);
+                }
+
+                if(length == 0 && (m_options & StringSplitOptions::RemoveEmptyEntries))
+                {
+                    continue;
+                }
+
+                m_current = m_source.Subsegment(start, length);
+
+                return true;
+            }
+
+            m_current = StringSegment();
+
+            return false;
+        }
+
+        void StringSplitEnumerator::Reset()
+        {
+            m_position = 0;
+            m_current = StringSegment();
+        }
+
+        Array<String> StringSplitEnumerator::ToArray() const
+        {
+            StringSplitEnumerator counter(*this);
+            int64_t count = 0;
+
+            while(counter.MoveNext())
+            {
+                ++count;
+            }
+
+            Array<String> entries(count);
+            StringSplitEnumerator enumerator(*this);
+
+            for(int64_t i = 0; i < count && enumerator.MoveNext(); ++i)
+            {
+                entries[i] = enumerator.Current().ToString();
+            }
+
+            return entries;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef _DOTNETNATIVE_SYSTEM_STRINGSPLITENUMERATOR_H_
+#define _DOTNETNATIVE_SYSTEM_STRINGSPLITENUMERATOR_H_
+
+#include "Array.h"
+#include "Object.h"
+#include "StringSegment.h"
+#include "StringSplitOptions.h"
+#include "Collections/IEnumerator.h"
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        // Enumerates the entries of a split string as segments of the source, finding each separator only when the
+        // enumerator advances, so splitting allocates nothing. Returned by String::Split and StringSegment::Split.
+        class StringSplitEnumerator
+            : public Object
+            , public Collections::IEnumerator<StringSegment>
+        {
+        private:
+            enum class SeparatorKind
+            {
+                None,           // an empty separator string, the source is a single entry
+                Char,
+                CharSet,
+                WhiteSpace,     // an empty char set
+                String
+            };
+
+            StringSegment      m_source;
+            StringSegment      m_separators;    // the char set or separator string, read as UTF-16
+            utf16char          m_separator;
+            SeparatorKind      m_kind;
+            StringSplitOptions m_options;
+            int                m_position;      // where the next entry starts, past the end once enumerated
+            StringSegment      m_current;
+
+        private:
+            // Returns the index of the next separator in chars, or -1, and its length.
+            int FindSeparator(const utf16char *chars, const int length, int &separatorLength) const noexcept;
+
+        public:
+            StringSplitEnumerator(const StringSegment &source, const utf16char separator, const StringSplitOptions options);
+            StringSplitEnumerator(const StringSegment &source, const utf16char *separators, const int count, const StringSplitOptions options);
+            StringSplitEnumerator(const StringSegment &source, const String &separator, const StringSplitOptions options);
+            virtual ~StringSplitEnumerator() {}
+
+            //
+            // Summary:
+            //     Gets the element in the collection at the current position of the enumerator.
+            //
+            // Returns:
+            //     The element in the collection at the current position of the enumerator.
+            virtual const StringSegment& Current() const & override;
+
+            //
+            // Summary:
+            //     Gets the element in the collection at the current position of the enumerator.
+            //
+            // Returns:
+            //     The element in the collection at the current position of the enumerator.
+            virtual StringSegment& Current() & override;
+
+            //
+            // Summary:
+            //     Advances the enumerator to the next element of the collection.
+            //
+            // Returns:
+            //     true if the enumerator was successfully advanced to the next element; false if
+            //     the enumerator has passed the end of the collection.
+            virtual bool MoveNext() override;
+
+            //
+            // Summary:
+            //     Sets the enumerator to its initial position, which is before the first element
+            //     in the collection.
+            virtual void Reset() override;
+
+            // Counts the remaining entries, then copies them into an array of exactly that size.
+            Array<String> ToArray() const;
+        };
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef _DOTNETNATIVE_SYSTEM_STRINGSPLITOPTIONS_H_
+#define _DOTNETNATIVE_SYSTEM_STRINGSPLITOPTIONS_H_
+
+namespace DotNetNative
+{
+    namespace System
+    {
+        //
+        // Summary:
+        //     Specifies options for applicable String.Split method overloads, such as whether
+        //     to omit empty substrings from the returned array or trim whitespace from substrings.
+        enum class StringSplitOptions
+        {
+            //
+            // Summary:
+            //     Use the default options when splitting strings.
+            None = 0,
+
+            //
+            // Summary:
+            //     Omit array elements that contain an empty string from the result.
+            RemoveEmptyEntries = 1,
+
+            //
+            // Summary:
+            //     Trim white-space characters from each substring in the result.
+            TrimEntries = 2
+        };
+
+        constexpr StringSplitOptions operator|(const StringSplitOptions a, const StringSplitOptions b) noexcept
+        {
+            return static_cast<StringSplitOptions>(static_cast<int>(a) | static_cast<int>(b));
+        }
+
+        constexpr bool operator&(const StringSplitOptions a, const StringSplitOptions b) noexcept
+        {
+            return (static_cast<int>(a) & static_cast<int>(b)) != 0;
+        }
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "Latin1Utility.h"
+#include "../Numerics/BitOperations.h"
+
+#ifdef DNN_SSE2
+#include <immintrin.h>
+#endif
+
+namespace DotNetNative { namespace System { namespace Text {
+
+    void Latin1Utility::WidenLatin1ToUtf16(const char *source, utf16char *destination, size_t length) noexcept
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t*>(source);
+        size_t i = 0;
+
+#ifdef DNN_AVX2
+        for(; i + 32 <= length; i += 32)
+        {
+            const __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(vector)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(vector, 1)));
+        }
+#endif
+
+#ifdef DNN_SSE2
+        if(length >= 16)
+        {
+            const __m128i zero = _mm_setzero_si128();
+
+            for(; i + 16 <= length; i += 16)
+            {
+                const __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_unpacklo_epi8(vector, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_unpackhi_epi8(vector, zero));
+            }
+
+            // Widen the remainder by redoing the last 16 characters, which overlap the ones already written.
+            if(i < length)
+            {
+                const size_t last = length - 16;
+                const __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + last));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + last), _mm_unpacklo_epi8(vector, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + last + 8), _mm_unpackhi_epi8(vector, zero));
+            }
+
+            return;
+        }
+#endif
+
+        for(; i < length; ++i)
+        {
+            destination[i] = bytes[i];
+        }
+    }
+
+    size_t Latin1Utility::GetIndexOfFirstNonLatin1Char(const utf16char *buffer, size_t length) noexcept
+    {
+        size_t i = 0;
+
+#ifdef DNN_AVX2
+        for(; i + 16 <= length; i += 16)
+        {
+            const __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer + i));
+            const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_srli_epi16(vector, 8), _mm256_setzero_si256())));
+
+            if(mask != 0)
+            {
+                return i + Numerics::BitOperations::TrailingZeroCount(mask) / 2;
+            }
+        }
+#endif
+
+#ifdef DNN_SSE2
+        for(; i + 8 <= length; i += 8)
+        {
+            const __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_srli_epi16(vector, 8), _mm_setzero_si128()))) ^ 0xffff;
+
+            if(mask != 0)
+            {
+                return i + Numerics::BitOperations::TrailingZeroCount(mask) / 2;
+            }
+        }
+#endif
+
+        while(i < length && buffer[i] <= 0xff)
+        {
+            ++i;
+        }
+
+        return i;
+    }
+
+    void Latin1Utility::NarrowUtf16ToLatin1(const utf16char *source, char *destination, size_t length) noexcept
+    {
+        uint8_t *bytes = reinterpret_cast<uint8_t*>(destination);
+        size_t i = 0;
+
+#ifdef DNN_SSE2
+        // The characters fit a byte, so packing with unsigned saturation keeps them as they are.
+        for(; i + 16 <= length; i += 16)
+        {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 8));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i), _mm_packus_epi16(low, high));
+        }
+#endif
+
+        for(; i < length; ++i)
+        {
+            bytes[i] = static_cast<uint8_t>(source[i]);
+        }
+    }
+}}}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef _DOTNETNATIVE_SYSTEM_TEXT_LATIN1UTILITY_H_
+#define _DOTNETNATIVE_SYSTEM_TEXT_LATIN1UTILITY_H_
+
+#include "../../GlobalDefs.h"
+
+#include <cstddef>
+
+namespace DotNetNative { namespace System { namespace Text {
+
+    class Latin1Utility
+    {
+    private:
+        Latin1Utility() = delete;
+        Latin1Utility(const Latin1Utility &copy) = delete;
+        Latin1Utility(Latin1Utility &&mov) = delete;
+        ~Latin1Utility() = delete;
+
+    public:
+        /// <summary>
+        /// Copies <paramref name="length"/> Latin-1 (and therefore ASCII) characters from <paramref name="source"/>
+        /// to <paramref name="destination"/>, zero-extending each byte to a UTF-16 code unit.
+        /// </summary>
+        static void WidenLatin1ToUtf16(const char *source, utf16char *destination, size_t length) noexcept;
+
+        /// <summary>
+        /// Returns the index of the first character in <paramref name="buffer"/> that is not Latin-1 (above U+00FF),
+        /// or <paramref name="length"/> when all of them are.
+        /// </summary>
+        static size_t GetIndexOfFirstNonLatin1Char(const utf16char *buffer, size_t length) noexcept;
+
+        /// <summary>
+        /// Copies <paramref name="length"/> UTF-16 code units, all of them Latin-1, from <paramref name="source"/> to
+        /// <paramref name="destination"/>, one byte each.
+        /// </summary>
+        static void NarrowUtf16ToLatin1(const utf16char *source, char *destination, size_t length) noexcept;
+    };
+}}}
+
+#endif
\ No newline at end of file
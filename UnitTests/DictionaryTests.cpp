@@ -2,6 +2,9 @@
 #include "CppUnitTest.h"
 #include "../DotNetNative/System/Collections/Dictionary.h"
 #include "../DotNetNative/System/Array.h"
+#include "../DotNetNative/System/String.h"
+
+#include <cstdio>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace DotNetNative;
@@ -45,5 +48,36 @@ namespace UnitTests
             Assert::IsTrue(dict.ContainsKey(1));
             Assert::IsFalse(dict.ContainsKey(0));
         }
+
+        TEST_METHOD(TestStringKeys)
+        {
+            Dictionary<String, int> dict;
+
+            dict.Add(String("id"), 1);
+            dict.Add(String("a.much.longer.identifier"), 2);
+
+            Assert::AreEqual(dict[String("id")], 1);
+            Assert::AreEqual(dict[String("a.much.longer.identifier")], 2);
+            Assert::IsTrue(dict.ContainsKey(String("a.much.longer.identifier")));
+            Assert::IsFalse(dict.ContainsKey(String("a.much.longer.identifiex")));
+            Assert::IsFalse(dict.ContainsKey(String()));
+
+            // Enough keys to resize the table a few times.
+            char key[16];
+
+            for(int i = 0; i < 100; ++i)
+            {
+                snprintf(key, sizeof(key), "key%d", i);
+                dict.Add(String(key), i);
+            }
+
+            for(int i = 0; i < 100; ++i)
+            {
+                snprintf(key, sizeof(key), "key%d", i);
+                Assert::AreEqual(dict[String(key)], i);
+            }
+
+            Assert::AreEqual(dict.Count(), 102LL);
+        }
     };
 }
\ No newline at end of file
@@ -1,6 +1,22 @@
 #include "pch.h"
 #include "CppUnitTest.h"
 #include "../DotNetNative/MemoryUtil.h"
+#include "../DotNetNative/AllocationProfiler.h"
+#include "../DotNetNative/LargeAllocator.h"
+#include "../DotNetNative/MemoryArena.h"
+#include "../DotNetNative/MemoryResourceAllocator.h"
+#include "../DotNetNative/ObjectPool.h"
+#include "../DotNetNative/SizeClassAllocator.h"
+#include "../DotNetNative/System/Array.h"
+#include "../DotNetNative/System/String.h"
+#include "../DotNetNative/System/StringBuilder.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory_resource>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -9,6 +25,45 @@ namespace UnitTests
 	TEST_CLASS(MemoryTests)
 	{
     private:
+        // Counts the outstanding bytes of a monotonic resource; the upstream never touches Memory.
+        class CountingResource : public std::pmr::memory_resource
+        {
+        private:
+            char                                m_buffer[64 * 1024];
+            std::pmr::monotonic_buffer_resource m_upstream;
+
+        public:
+            size_t m_allocationCount;
+            size_t m_outstandingBytes;
+
+            CountingResource()
+                : m_upstream(m_buffer, sizeof(m_buffer), std::pmr::null_memory_resource())
+                , m_allocationCount(0)
+                , m_outstandingBytes(0)
+            {
+            }
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                ++m_allocationCount;
+                m_outstandingBytes += bytes;
+
+                return m_upstream.allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void *memory, size_t bytes, size_t alignment) override
+            {
+                m_outstandingBytes -= bytes;
+                m_upstream.deallocate(memory, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
         class TestObj
         {
         private:
@@ -38,6 +93,25 @@ namespace UnitTests
             inline bool* getBool() const noexcept { return m_bool; }
         };
 
+        class PooledObj final : public DotNetNative::PooledObject<PooledObj>
+        {
+        public:
+            int m_value;
+
+            PooledObj(int value) : m_value(value) {}
+        };
+
+        class ResettableObj
+        {
+        public:
+            int m_constructCount;
+            int m_resetCount;
+
+            ResettableObj() : m_constructCount(1), m_resetCount(0) {}
+
+            void Reset() { ++m_resetCount; }
+        };
+
 	public:
 		
         void CreateTestDescriptors(bool *isAllocated, DotNetNative::Memory::AllocatorDescriptors &descriptors)
@@ -121,6 +195,266 @@ namespace UnitTests
             Assert::IsFalse(objIsAllocated2);
 		}
 
+        TEST_METHOD(TestAllocatorHooks)
+        {
+            using DotNetNative::AllocatorHooks;
+            using DotNetNative::Memory;
+
+            int allocationCount = 0;
+            AllocatorHooks hooks = {};
+
+            hooks.m_context = &allocationCount;
+
+            hooks.m_alloc = [](void *context, size_t size)
+            {
+                ++*static_cast<int*>(context);
+
+                return ::malloc(size);
+            };
+
+            hooks.m_free = [](void *context, void *memory)
+            {
+                --*static_cast<int*>(context);
+
+                ::free(memory);
+            };
+
+            hooks.m_debugAlloc = [](void *context, size_t size, const char*, int)
+            {
+                ++*static_cast<int*>(context);
+
+                return ::malloc(size);
+            };
+
+            hooks.m_debugFree = [](void *context, void *memory, const char*, int)
+            {
+                --*static_cast<int*>(context);
+
+                ::free(memory);
+            };
+
+            Memory::SetAllocatorHooks(hooks);
+
+            // Hooks that were not provided fall back to the default backend.
+            Assert::IsTrue(Memory::GetAllocatorHooks().m_realloc == Memory::GetDefaultAllocatorHooks().m_realloc);
+
+            int *test = DNN_New int(21);
+
+            Assert::AreEqual(allocationCount, 1);
+
+            delete test;
+
+            Assert::AreEqual(allocationCount, 0);
+
+            DotNetNative::Allocator<int> allocator = DNN_Allocator(int);
+            std::vector<int, DotNetNative::Allocator<int>> values(allocator);
+
+            values.resize(100);
+
+            Assert::AreEqual(allocationCount, 1);
+
+            values = std::vector<int, DotNetNative::Allocator<int>>(allocator);
+
+            Assert::AreEqual(allocationCount, 0);
+
+            Memory::SetAllocatorHooks(Memory::GetDefaultAllocatorHooks());
+        }
+
+        TEST_METHOD(TestAllocatorScope)
+        {
+            using DotNetNative::AllocatorHooks;
+            using DotNetNative::Memory;
+
+            int outerCount = 0;
+            int innerCount = 0;
+            AllocatorHooks hooks = {};
+
+            hooks.m_alloc = [](void *context, size_t size)
+            {
+                ++*static_cast<int*>(context);
+
+                return ::malloc(size);
+            };
+
+            hooks.m_free = [](void *context, void *memory)
+            {
+                --*static_cast<int*>(context);
+
+                ::free(memory);
+            };
+
+            // Started up front, as creating a thread allocates on the creating thread.
+            std::atomic<bool> start(false);
+            std::atomic<bool> done(false);
+            std::thread thread([&start, &done]()
+            {
+                while(!start)
+                {
+                    std::this_thread::yield();
+                }
+
+                Memory::Free(Memory::Alloc(16));
+                done = true;
+            });
+
+            hooks.m_context = &outerCount;
+
+            {
+                Memory::AllocatorScope outerScope(hooks);
+
+                Assert::IsTrue(&Memory::GetCurrentAllocatorHooks() == &outerScope.Hooks());
+                Assert::IsTrue(Memory::GetAllocatorHooks().m_alloc == Memory::GetDefaultAllocatorHooks().m_alloc);
+
+                void *outer = Memory::Alloc(32);
+
+                Assert::AreEqual(outerCount, 1);
+
+                {
+                    hooks.m_context = &innerCount;
+
+                    Memory::AllocatorScope innerScope(hooks);
+
+                    void *inner = Memory::Alloc(64);
+
+                    Assert::AreEqual(outerCount, 1);
+                    Assert::AreEqual(innerCount, 1);
+
+                    // Other threads keep using the global hooks.
+                    start = true;
+
+                    while(!done)
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    Assert::AreEqual(outerCount, 1);
+                    Assert::AreEqual(innerCount, 1);
+
+                    // Without a sized hook the sized free goes to the scope's unsized one.
+                    Memory::Free(inner, 64);
+
+                    Assert::AreEqual(innerCount, 0);
+                }
+
+                Memory::Free(outer);
+
+                Assert::AreEqual(outerCount, 0);
+            }
+
+            thread.join();
+
+            Assert::IsTrue(&Memory::GetCurrentAllocatorHooks() == &Memory::GetAllocatorHooks());
+        }
+
+        TEST_METHOD(TestMemoryResource)
+        {
+            using DotNetNative::Memory;
+            using DotNetNative::MemoryResourceAllocator;
+
+            CountingResource resource;
+
+            {
+                Memory::AllocatorScope scope(MemoryResourceAllocator::CreateHooks(resource));
+
+                DotNetNative::System::String str("Hello from a memory resource");
+                DotNetNative::System::Array<int> array(100);
+
+                void *aligned = DNN_AlignedAlloc(100, 64);
+
+                Assert::IsTrue(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+
+                aligned = Memory::AlignedRealloc(aligned, 200, 64);
+
+                Assert::IsTrue(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+
+                DNN_AlignedFree(aligned);
+
+                Assert::IsTrue(resource.m_outstandingBytes >= 100 * sizeof(int));
+            }
+
+            Assert::IsTrue(resource.m_allocationCount >= 4);
+            Assert::AreEqual(resource.m_outstandingBytes, static_cast<size_t>(0));
+
+            const size_t allocationCount = resource.m_allocationCount;
+
+            {
+                DotNetNative::Allocator<int> allocator = DNN_ResourceAllocator(int, &resource);
+                std::vector<int, DotNetNative::Allocator<int>> values(allocator);
+
+                values.resize(100);
+
+                Assert::AreEqual(resource.m_allocationCount, allocationCount + 1);
+                Assert::AreEqual(resource.m_outstandingBytes, 100 * sizeof(int));
+                Assert::IsTrue(values.get_allocator() == allocator);
+                Assert::IsTrue(values.get_allocator() != DNN_Allocator(int));
+            }
+
+            Assert::AreEqual(resource.m_outstandingBytes, static_cast<size_t>(0));
+        }
+
+        TEST_METHOD(TestSizedFree)
+        {
+            using DotNetNative::AllocatorHooks;
+            using DotNetNative::Memory;
+
+            // Every sized free must hand back exactly the bytes that were allocated.
+            struct Counters
+            {
+                size_t m_outstandingBytes;
+                int    m_unsizedFrees;
+            } counters = {};
+
+            AllocatorHooks hooks = {};
+
+            hooks.m_context = &counters;
+
+            hooks.m_alloc = [](void *context, size_t size)
+            {
+                static_cast<Counters*>(context)->m_outstandingBytes += size;
+
+                return ::malloc(size);
+            };
+
+            hooks.m_free = [](void *context, void *memory)
+            {
+                ++static_cast<Counters*>(context)->m_unsizedFrees;
+
+                ::free(memory);
+            };
+
+            hooks.m_sizedFree = [](void *context, void *memory, size_t size)
+            {
+                static_cast<Counters*>(context)->m_outstandingBytes -= size;
+
+                ::free(memory);
+            };
+
+            hooks.m_debugAlloc = [](void *context, size_t size, const char*, int) { return Memory::GetAllocatorHooks().m_alloc(context, size); };
+            hooks.m_debugFree = [](void *context, void *memory, const char*, int) { Memory::GetAllocatorHooks().m_free(context, memory); };
+            hooks.m_debugSizedFree = [](void *context, void *memory, size_t size, const char*, int) { Memory::GetAllocatorHooks().m_sizedFree(context, memory, size); };
+
+            Memory::SetAllocatorHooks(hooks);
+
+            delete DNN_New TestObj();
+
+            DotNetNative::Allocator<double> allocator = DNN_Allocator(double);
+
+            allocator.deallocate(allocator.allocate(7), 7);
+
+            {
+                DotNetNative::System::String str("Hello");
+                DotNetNative::System::StringBuilder builder(str);
+
+                builder.Append("World", 5);
+                builder.ToString();
+            }
+
+            Memory::SetAllocatorHooks(Memory::GetDefaultAllocatorHooks());
+
+            Assert::AreEqual(counters.m_outstandingBytes, static_cast<size_t>(0));
+            Assert::AreEqual(counters.m_unsizedFrees, 0);
+        }
+
         TEST_METHOD(TestUniquePtr)
         {
             DotNetNative::Memory::AllocatorDescriptors descriptors;
@@ -219,5 +553,396 @@ namespace UnitTests
 
             Assert::IsFalse(objIsAllocated1);
         }
+
+        TEST_METHOD(TestArenaScope)
+        {
+            using DotNetNative::Memory;
+            using DotNetNative::MemoryArena;
+
+            void *heapMemory = Memory::Alloc(64);
+
+            {
+                Memory::ArenaScope scope;
+
+                char *memory = static_cast<char*>(Memory::Alloc(100));
+
+                Assert::IsTrue(scope.Arena().Owns(memory));
+                Assert::IsTrue(reinterpret_cast<uintptr_t>(memory) % MemoryArena::MinAlignment == 0);
+
+                memcpy(memory, "Hello World!", 13);
+
+                memory = static_cast<char*>(Memory::Realloc(memory, 1000));
+
+                Assert::IsTrue(scope.Arena().Owns(memory));
+                Assert::IsTrue(strcmp(memory, "Hello World!") == 0);
+
+                Memory::Free(memory);
+
+                bool objectAlive = false;
+                TestObj *obj = DNN_New TestObj(&objectAlive);
+
+                Assert::IsTrue(scope.Arena().Owns(obj));
+
+                delete obj;
+
+                Assert::IsFalse(objectAlive);
+                Assert::IsFalse(scope.Arena().Owns(heapMemory));
+
+                void *oversize = Memory::Alloc(MemoryArena::DefaultMaxBlockSize + 1);
+
+                Assert::IsFalse(scope.Arena().Owns(oversize));
+
+                Memory::Free(oversize);
+
+                {
+                    Memory::ArenaScope innerScope(4096, 256);
+
+                    void *inner = Memory::Alloc(16);
+
+                    Assert::IsTrue(innerScope.Arena().Owns(inner));
+                    Assert::IsFalse(scope.Arena().Owns(inner));
+
+                    // Blocks of an outer arena are still recognized while an inner scope is active.
+                    Memory::Free(memory);
+                }
+
+                const MemoryArena::Statistics &statistics = scope.GetStatistics();
+
+                Assert::AreEqual(statistics.m_allocationCount, static_cast<size_t>(2));
+                Assert::AreEqual(statistics.m_oversizeCount, static_cast<size_t>(1));
+                Assert::AreEqual(statistics.m_chunkCount, static_cast<size_t>(1));
+            }
+
+            Assert::IsNull(Memory::ArenaScope::Current());
+
+            Memory::Free(heapMemory);
+        }
+
+        TEST_METHOD(TestAlignedAlloc)
+        {
+            for(size_t alignment : { 16, 32, 64, 4096 })
+            {
+                int *values = static_cast<int*>(DNN_AlignedCAlloc(100, sizeof(int), alignment));
+
+                Assert::IsNotNull(values);
+                Assert::IsTrue(reinterpret_cast<uintptr_t>(values) % alignment == 0);
+
+                for(int i = 0; i < 100; ++i)
+                {
+                    Assert::AreEqual(values[i], 0);
+
+                    values[i] = i;
+                }
+
+                values = static_cast<int*>(DNN_AlignedRealloc(values, 5000 * sizeof(int), alignment));
+
+                Assert::IsTrue(reinterpret_cast<uintptr_t>(values) % alignment == 0);
+
+                for(int i = 0; i < 100; ++i)
+                {
+                    Assert::AreEqual(values[i], i);
+                }
+
+                values = static_cast<int*>(DNN_AlignedRealloc(values, 10 * sizeof(int), alignment));
+
+                Assert::IsTrue(reinterpret_cast<uintptr_t>(values) % alignment == 0);
+                Assert::AreEqual(values[9], 9);
+
+                DNN_AlignedFree(values);
+            }
+        }
+
+        TEST_METHOD(TestLargeAllocator)
+        {
+            using DotNetNative::LargeAllocator;
+            using DotNetNative::Memory;
+
+            const size_t size = 4 * 1024 * 1024;
+            const LargeAllocator::Statistics before = LargeAllocator::GetStatistics();
+
+            void *small = Memory::Alloc(64);
+            unsigned char *memory = static_cast<unsigned char*>(Memory::CAlloc(size, 1));
+
+            Assert::IsFalse(LargeAllocator::Owns(small));
+            Assert::IsTrue(LargeAllocator::Owns(memory));
+            Assert::AreEqual(LargeAllocator::GetStatistics().m_blockCount, before.m_blockCount + 1);
+            Assert::IsTrue(reinterpret_cast<uintptr_t>(memory) % LargeAllocator::HeaderSize == 0);
+            Assert::IsTrue(memory[0] == 0 && memory[size - 1] == 0);
+
+            memory[0] = 1;
+            memory[size - 1] = 2;
+            memory = static_cast<unsigned char*>(Memory::Realloc(memory, size * 4));
+
+            Assert::IsTrue(LargeAllocator::Owns(memory));
+            Assert::AreEqual(LargeAllocator::GetSize(memory), size * 4);
+            Assert::IsTrue(memory[0] == 1 && memory[size - 1] == 2);
+
+#ifndef _WIN32
+            Assert::AreEqual(LargeAllocator::GetStatistics().m_remapCount, before.m_remapCount + 1);
+#endif
+
+            Memory::Free(memory);
+            Memory::Free(small);
+
+            Assert::AreEqual(LargeAllocator::GetStatistics().m_blockCount, before.m_blockCount);
+
+            // Arrays of trivial elements are reallocated, so they move into the large allocator as they grow.
+            DotNetNative::System::Array<int> values(1000);
+
+            values[999] = 42;
+            DotNetNative::System::Array<int>::Resize(values, 1024 * 1024);
+
+            Assert::AreEqual(values.Length(), static_cast<int64_t>(1024 * 1024));
+            Assert::AreEqual(values[999], 42);
+            Assert::AreEqual(values[1024 * 1024 - 1], 0);
+            Assert::AreEqual(LargeAllocator::GetStatistics().m_blockCount, before.m_blockCount + 1);
+
+            DotNetNative::System::Array<int>::Resize(values, 0);
+
+            Assert::AreEqual(LargeAllocator::GetStatistics().m_blockCount, before.m_blockCount);
+
+            DotNetNative::System::Array<DotNetNative::System::String> strings(2);
+
+            strings[1] = DotNetNative::System::String("moved");
+            DotNetNative::System::Array<DotNetNative::System::String>::Resize(strings, 3);
+
+            Assert::IsTrue(strings[1] == DotNetNative::System::String("moved"));
+        }
+
+        TEST_METHOD(TestSizeClassAllocator)
+        {
+            using DotNetNative::SizeClassAllocator;
+
+            Assert::AreEqual(SizeClassAllocator::GetSizeClass(1), 0);
+            Assert::AreEqual(SizeClassAllocator::GetSizeClassSize(SizeClassAllocator::GetSizeClass(17)), static_cast<size_t>(32));
+            Assert::AreEqual(SizeClassAllocator::GetSizeClass(SizeClassAllocator::MaxSmallSize + 1), -1);
+
+            char *small = static_cast<char*>(SizeClassAllocator::Alloc(24));
+
+            Assert::IsTrue(SizeClassAllocator::IsSmallBlock(small));
+            Assert::IsTrue(reinterpret_cast<uintptr_t>(small) % SizeClassAllocator::MinAlignment == 0);
+
+            memcpy(small, "Hello World!", 13);
+
+            small = static_cast<char*>(SizeClassAllocator::Realloc(small, 1024));
+
+            Assert::IsTrue(strcmp(small, "Hello World!") == 0);
+
+            small = static_cast<char*>(SizeClassAllocator::Realloc(small, SizeClassAllocator::MaxSmallSize * 2));
+
+            Assert::IsFalse(SizeClassAllocator::IsSmallBlock(small));
+            Assert::IsTrue(strcmp(small, "Hello World!") == 0);
+
+            SizeClassAllocator::Free(small);
+
+            small = static_cast<char*>(SizeClassAllocator::Alloc(100));
+
+            SizeClassAllocator::Free(small, 100);
+
+            void *aligned = SizeClassAllocator::AlignedAlloc(100, 64);
+
+            Assert::IsTrue(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+
+            SizeClassAllocator::AlignedFree(aligned);
+
+            aligned = SizeClassAllocator::AlignedAlloc(100, 64);
+
+            SizeClassAllocator::AlignedFree(aligned, 100, 64);
+        }
+
+        TEST_METHOD(TestSizeClassAllocatorThreads)
+        {
+            using DotNetNative::SizeClassAllocator;
+
+            // Blocks are allocated on one thread and released on another to exercise the depot.
+            std::vector<std::vector<void*>> blocks(8);
+            std::vector<std::thread> threads;
+
+            for(size_t i = 0; i < blocks.size(); ++i)
+            {
+                threads.emplace_back([&blocks, i]()
+                {
+                    for(size_t j = 0; j < 10000; ++j)
+                    {
+                        const size_t size = 1 + ((i * 7919 + j * 31) % 2048);
+                        unsigned char *memory = static_cast<unsigned char*>(SizeClassAllocator::Alloc(size));
+
+                        memory[0] = static_cast<unsigned char>(i);
+                        memory[size - 1] = static_cast<unsigned char>(i);
+
+                        blocks[i].push_back(memory);
+                    }
+                });
+            }
+
+            for(std::thread &thread : threads)
+            {
+                thread.join();
+            }
+
+            threads.clear();
+
+            for(size_t i = 0; i < blocks.size(); ++i)
+            {
+                threads.emplace_back([&blocks, i]()
+                {
+                    const std::vector<void*> &owned = blocks[(i + 1) % blocks.size()];
+
+                    for(void *memory : owned)
+                    {
+                        Assert::AreEqual(static_cast<int>(*static_cast<unsigned char*>(memory)), static_cast<int>((i + 1) % blocks.size()));
+
+                        SizeClassAllocator::Free(memory);
+                    }
+
+                    SizeClassAllocator::FlushThreadCache();
+                });
+            }
+
+            for(std::thread &thread : threads)
+            {
+                thread.join();
+            }
+
+            Assert::IsTrue(SizeClassAllocator::GetStatistics().m_slabCount > 0);
+        }
+
+        TEST_METHOD(TestAllocationProfiler)
+        {
+            using DotNetNative::AllocationProfiler;
+
+            const char *fileName = "AllocationProfilerTest.cpp";
+
+            AllocationProfiler::Reset();
+            AllocationProfiler::Start(1);
+
+            Assert::IsTrue(AllocationProfiler::IsRunning());
+
+            for(int i = 0; i < 100; ++i)
+            {
+                AllocationProfiler::OnAllocation(64, fileName, 10);
+                AllocationProfiler::OnAllocation(4096, fileName, 20);
+            }
+
+            AllocationProfiler::Stop();
+            AllocationProfiler::OnAllocation(64, fileName, 30);
+
+            Assert::IsFalse(AllocationProfiler::IsRunning());
+
+            AllocationProfiler::Snapshot snapshot = AllocationProfiler::TakeSnapshot();
+            const AllocationProfiler::CallSite *small = nullptr;
+            const AllocationProfiler::CallSite *large = nullptr;
+
+            for(const AllocationProfiler::CallSite &callSite : snapshot.m_callSites)
+            {
+                Assert::AreNotEqual(callSite.m_lineNumber, 30);
+
+                if(std::strcmp(callSite.m_fileName, fileName) == 0)
+                {
+                    (callSite.m_lineNumber == 10 ? small : large) = &callSite;
+                }
+            }
+
+            // With a one byte interval every allocation is sampled with a weight of one.
+            Assert::IsNotNull(small);
+            Assert::IsNotNull(large);
+            Assert::AreEqual(small->m_allocationCount, static_cast<uint64_t>(100));
+            Assert::AreEqual(small->m_allocatedBytes, static_cast<uint64_t>(6400));
+            Assert::AreEqual(large->m_allocatedBytes, static_cast<uint64_t>(409600));
+            Assert::IsTrue(large < small);
+
+            std::ostringstream text;
+            std::ostringstream json;
+
+            AllocationProfiler::WriteText(text, snapshot);
+            AllocationProfiler::WriteJson(json, snapshot);
+
+            Assert::IsTrue(text.str().find("AllocationProfilerTest.cpp:20") != std::string::npos);
+            Assert::IsTrue(json.str().find("{\"file\":\"AllocationProfilerTest.cpp\",\"line\":10,") != std::string::npos);
+
+            AllocationProfiler::Reset();
+
+            Assert::IsTrue(AllocationProfiler::TakeSnapshot().m_callSites.empty());
+        }
+
+        TEST_METHOD(TestObjectPool)
+        {
+            using DotNetNative::ObjectPool;
+            using DotNetNative::ObjectPoolPolicy;
+
+            typedef ObjectPool<PooledObj> Pool;
+
+            Pool::Clear();
+
+            PooledObj *first = Pool::Acquire(1);
+            Pool::Release(first);
+
+            PooledObj *second = Pool::Acquire(2);
+
+            Assert::IsTrue(first == second);
+            Assert::AreEqual(second->m_value, 2);
+
+            Pool::Release(second);
+
+            // new and delete of a PooledObject go through the same pool.
+            PooledObj *created = new PooledObj(3);
+
+            Assert::IsTrue(created == first);
+
+            delete created;
+
+            // Released objects beyond the thread capacity spill into the bounded shared list.
+            const size_t count = ObjectPoolPolicy<PooledObj>::ThreadCapacity * 4;
+            std::vector<PooledObj*> objects;
+
+            for(size_t i = 0; i < count; ++i)
+            {
+                objects.push_back(Pool::Acquire(static_cast<int>(i)));
+            }
+
+            for(PooledObj *object : objects)
+            {
+                Pool::Release(object);
+            }
+
+            Assert::IsTrue(Pool::GetThreadCachedCount() <= ObjectPoolPolicy<PooledObj>::ThreadCapacity);
+            Assert::AreEqual(Pool::GetThreadCachedCount() + Pool::GetSharedCachedCount(), count);
+
+            // Objects cached by an exiting thread move to the shared list.
+            Pool::Clear();
+
+            std::thread([]()
+            {
+                Pool::Release(Pool::Acquire(0));
+            }).join();
+
+            Assert::AreEqual(Pool::GetThreadCachedCount(), static_cast<size_t>(0));
+            Assert::AreEqual(Pool::GetSharedCachedCount(), static_cast<size_t>(1));
+
+            Pool::Clear();
+
+            Assert::AreEqual(Pool::GetSharedCachedCount(), static_cast<size_t>(0));
+
+            // With the reset policy objects stay constructed between uses.
+            typedef ObjectPool<ResettableObj, DotNetNative::ResetOnReturnPolicy<ResettableObj>> ResetPool;
+
+            ResettableObj *resettable = ResetPool::Acquire();
+            ResetPool::Release(resettable);
+
+            ResettableObj *reused = ResetPool::Acquire();
+
+            Assert::IsTrue(reused == resettable);
+            Assert::AreEqual(reused->m_constructCount, 1);
+            Assert::AreEqual(reused->m_resetCount, 1);
+
+            ResetPool::Release(reused);
+            ResetPool::Clear();
+
+            // Enumerators handed out by the library reuse their storage.
+            DotNetNative::System::String str("abc");
+            const void *enumerator = str.GetEnumerator().get();
+
+            Assert::IsTrue(str.GetEnumerator().get() == enumerator);
+        }
 	};
 }
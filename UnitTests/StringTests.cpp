@@ -1,7 +1,19 @@
 #include "pch.h"
 #include "CppUnitTest.h"
+#include "../DotNetNative/MemoryArena.h"
 #include "../DotNetNative/MemoryUtil.h"
+#include "../DotNetNative/System/Collections/Dictionary.h"
+#include "../DotNetNative/System/CharUnicodeInfo.h"
+#include "../DotNetNative/System/Environment.h"
 #include "../DotNetNative/System/StringBuilder.h"
+#include "../DotNetNative/System/StringComparer.h"
+#include "../DotNetNative/System/StringSegment.h"
+#include "../DotNetNative/System/StringSplitEnumerator.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace DotNetNative;
@@ -11,9 +23,1006 @@ namespace UnitTests
 {
     TEST_CLASS(StringTests)
     {
+    private:
+        // Counts the allocations, the bytes allocated and the releases made on the calling thread while alive.
+        class AllocationCounter
+        {
+        private:
+            int                    m_counts[3];
+            Memory::AllocatorScope m_scope;
+
+            static AllocatorHooks CreateHooks(int *counts)
+            {
+                AllocatorHooks hooks = {};
+
+                hooks.m_context = counts;
+                hooks.m_alloc = [](void *context, size_t size)
+                {
+                    ++static_cast<int*>(context)[0];
+                    static_cast<int*>(context)[2] += static_cast<int>(size);
+
+                    return ::malloc(size);
+                };
+                hooks.m_free = [](void *context, void *memory)
+                {
+                    ++static_cast<int*>(context)[1];
+
+                    ::free(memory);
+                };
+                hooks.m_debugAlloc = [](void *context, size_t size, const char *fileName, int lineNumber)
+                {
+                    ++static_cast<int*>(context)[0];
+                    static_cast<int*>(context)[2] += static_cast<int>(size);
+
+                    return ::malloc(size);
+                };
+                hooks.m_debugFree = [](void *context, void *memory, const char *fileName, int lineNumber)
+                {
+                    ++static_cast<int*>(context)[1];
+
+                    ::free(memory);
+                };
+
+                return hooks;
+            }
+
+        public:
+            AllocationCounter()
+                : m_counts{}
+                , m_scope(CreateHooks(m_counts))
+            {
+            }
+
+            int Count() const noexcept { return m_counts[0]; }
+            int FreeCount() const noexcept { return m_counts[1]; }
+            int Bytes() const noexcept { return m_counts[2]; }
+        };
+
+    public:
         TEST_METHOD(ConstructorAscii)
         {
             Assert::IsTrue(String("Hello World!") == "Hello World!");
         }
+
+        TEST_METHOD(InlineStorage)
+        {
+            {
+                AllocationCounter counter;
+
+                String empty;
+                String shortString("Identifier1");
+                String copy(shortString);
+                String moved(std::move(copy));
+
+                copy = moved;
+
+                Assert::AreEqual(counter.Count(), 0);
+                Assert::AreEqual(shortString.Length(), 11);
+                Assert::IsTrue(shortString.Equals(moved));
+                Assert::IsTrue(copy == static_cast<const utf16char*>(shortString));
+                Assert::IsTrue(moved == "Identifier1");
+                Assert::IsTrue(static_cast<const utf16char*>(empty) != nullptr);
+                Assert::IsTrue(empty == "");
+            }
+
+            {
+                AllocationCounter counter;
+
+                String longString("Identifier12");
+                const int allocationCount = counter.Count();
+                String copy(longString);
+
+                Assert::IsTrue(allocationCount > 0);
+                Assert::AreEqual(counter.Count(), allocationCount);
+                Assert::IsTrue(static_cast<const utf16char*>(copy) == static_cast<const utf16char*>(longString));
+            }
+
+            String shortString("abc");
+            String longString("abcdefghijklmnop");
+
+            Assert::IsTrue(shortString[2] == 'c');
+            Assert::IsTrue(longString[15] == 'p');
+            Assert::IsTrue(static_cast<const utf16char*>(shortString)[3] == 0);
+            Assert::IsFalse(shortString.Equals(longString));
+            Assert::ExpectException<IndexOutOfRangeException>([&shortString]() { shortString[3]; });
+
+            longString = shortString;
+
+            Assert::IsTrue(longString == "abc");
+
+            shortString = String("abcdefghijklmnop");
+
+            Assert::IsTrue(shortString == "abcdefghijklmnop");
+
+            utf16char enumerated[4] = {};
+            int count = 0;
+            unique_ptr<Collections::IEnumerator<utf16char>> enumerator = String("xyz").GetEnumerator();
+
+            while(enumerator->MoveNext())
+            {
+                enumerated[count++] = enumerator->Current();
+            }
+
+            Assert::IsTrue(String("xyz") == enumerated);
+        }
+
+        TEST_METHOD(SharedBuffer)
+        {
+            AllocationCounter counter;
+
+            {
+                String str("A string that lives on the heap");
+                String copy(str);
+                String assigned;
+
+                assigned = copy;
+
+                String moved(std::move(copy));
+
+                // One block per string, shared by every copy.
+                Assert::AreEqual(counter.Count(), 1);
+                Assert::IsTrue(static_cast<const utf16char*>(assigned) == static_cast<const utf16char*>(str));
+                Assert::IsTrue(static_cast<const utf16char*>(moved) == static_cast<const utf16char*>(str));
+                Assert::AreEqual(copy.Length(), 0);
+
+                str = String();
+
+                Assert::AreEqual(counter.FreeCount(), 0);
+                Assert::IsTrue(moved == "A string that lives on the heap");
+            }
+
+            Assert::AreEqual(counter.FreeCount(), 1);
+
+            StringBuilder builder("Hello, string builder", 21);
+
+            Assert::IsTrue(builder.ToString() == "Hello, string builder");
+            Assert::IsTrue(builder.ToString(7, 6) == "string");
+            Assert::IsTrue(builder.ToString(0, 0) == "");
+        }
+
+        TEST_METHOD(HashCode)
+        {
+            String shortString("key");
+            String longString("configuration.section.key");
+            StringBuilder builder("configuration.section.key", 25);
+
+            Assert::AreEqual(shortString.GetHashCode(), String("key").GetHashCode());
+            Assert::AreEqual(longString.GetHashCode(), builder.ToString().GetHashCode());
+            Assert::AreEqual(longString.GetHashCode(), longString.GetHashCode());
+            Assert::AreNotEqual(longString.GetHashCode(), String("configuration.section.kez").GetHashCode());
+            Assert::AreEqual(String().GetHashCode(), String("").GetHashCode());
+        }
+
+        TEST_METHOD(WidenFromChar)
+        {
+            char text[100];
+
+            for(int i = 0; i < 99; ++i)
+            {
+                text[i] = static_cast<char>('!' + i % 90);
+            }
+
+            // Lengths around the inline capacity and the vector widths, including remainders.
+            for(int length = 0; length < 100; ++length)
+            {
+                char terminated[100];
+
+                memcpy(terminated, text, length);
+                terminated[length] = 0;
+
+                String fromTerminated(terminated);
+                String fromLength(text, length);
+                StringBuilder builder(text, length);
+                StringBuilder appended;
+
+                appended.Append(text, length);
+
+                Assert::AreEqual(length, fromTerminated.Length());
+                Assert::AreEqual(length, fromLength.Length());
+                Assert::IsTrue(fromLength == builder.ToString());
+                Assert::IsTrue(fromLength == appended.ToString());
+
+                for(int i = 0; i < length; ++i)
+                {
+                    Assert::AreEqual(static_cast<utf16char>(text[i]), fromTerminated[i]);
+                    Assert::AreEqual(static_cast<utf16char>(text[i]), fromLength[i]);
+                }
+
+                Assert::AreEqual(static_cast<utf16char>(0), static_cast<const utf16char*>(fromLength)[length]);
+            }
+
+            // Bytes above 0x7F are read as Latin-1.
+            const char latin1[] = "caf\xE9 cr\xE8me br\xFBl\xE9" "e";
+            String widened(latin1);
+
+            Assert::AreEqual(static_cast<utf16char>(0xE9), widened[3]);
+            Assert::AreEqual(static_cast<utf16char>(0xFB), widened[13]);
+        }
+
+        TEST_METHOD(EqualityAndOrdering)
+        {
+            char text[81];
+
+            for(int i = 0; i < 80; ++i)
+            {
+                text[i] = static_cast<char>('a' + i % 26);
+            }
+
+            text[80] = 0;
+
+            // A difference at every position of strings that span several vectors and a remainder.
+            for(int length = 1; length <= 80; length += 7)
+            {
+                const String str(text, length);
+                const String same(text, length);
+                utf16char wide[81];
+
+                for(int i = 0; i <= length; ++i)
+                {
+                    wide[i] = i < length ? static_cast<utf16char>(text[i]) : 0;
+                }
+
+                char terminated[81];
+
+                memcpy(terminated, text, length);
+                terminated[length] = 0;
+
+                Assert::IsTrue(str == same);
+                Assert::IsTrue(str == terminated);
+                Assert::IsTrue(str == static_cast<const utf16char*>(wide));
+                Assert::AreEqual(0, String::CompareOrdinal(str, same));
+
+                for(int i = 0; i < length; ++i)
+                {
+                    terminated[i] = 'A';
+                    wide[i] = 0x100 + 'a';
+
+                    const String different(terminated, length);
+
+                    Assert::IsFalse(str == different);
+                    Assert::IsFalse(str == terminated);
+                    Assert::IsFalse(str == static_cast<const utf16char*>(wide));
+                    Assert::IsTrue(String::CompareOrdinal(different, str) < 0);
+                    Assert::IsTrue(String::CompareOrdinal(str, different) > 0);
+                    Assert::IsTrue(different < str);
+
+                    terminated[i] = text[i];
+                    wide[i] = static_cast<utf16char>(text[i]);
+                }
+
+                // Prefixes order first.
+                const String shorter(text, length - 1);
+
+                Assert::IsFalse(str == String(text, length + 1));
+                Assert::IsTrue(String::CompareOrdinal(shorter, str) < 0);
+                Assert::IsTrue(String::CompareOrdinal(str, shorter) > 0);
+            }
+
+            // Latin-1 chars compare equal to the same code points.
+            const utf16char wideLatin1[] = { 'n', 0xE4, 'i', 'v', 'e', 0 };
+
+            Assert::IsTrue(String("n\xE4ive") == static_cast<const utf16char*>(wideLatin1));
+            Assert::IsTrue(String(wideLatin1) == "n\xE4ive");
+            Assert::IsTrue(String() == "");
+            Assert::IsFalse(String("a") == "");
+        }
+
+        static int NaiveIndexOf(const String &str, const String &value)
+        {
+            for(int i = 0; i + value.Length() <= str.Length(); ++i)
+            {
+                int j = 0;
+
+                while(j < value.Length() && str[i + j] == value[j])
+                {
+                    ++j;
+                }
+
+                if(j == value.Length())
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        static int NaiveLastIndexOf(const String &str, const String &value)
+        {
+            for(int i = str.Length() - value.Length(); i >= 0; --i)
+            {
+                int j = 0;
+
+                while(j < value.Length() && str[i + j] == value[j])
+                {
+                    ++j;
+                }
+
+                if(j == value.Length())
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        TEST_METHOD(Search)
+        {
+            String str("key=value; path=/usr/local/bin; key2=value2");
+
+            Assert::AreEqual(3, str.IndexOf('='));
+            Assert::AreEqual(15, str.IndexOf('=', 4));
+            Assert::AreEqual(-1, str.IndexOf('#'));
+            Assert::AreEqual(36, str.LastIndexOf('='));
+            Assert::AreEqual(9, str.IndexOfAny(reinterpret_cast<const utf16char*>(u";/"), 2));
+            Assert::AreEqual(11, str.IndexOf(String("path")));
+            Assert::AreEqual(32, str.IndexOf(String("key"), 1));
+            Assert::AreEqual(32, str.LastIndexOf(String("key")));
+            Assert::AreEqual(0, str.IndexOf(String()));
+            Assert::IsTrue(str.Contains(String("/local/")));
+            Assert::IsFalse(str.Contains(String("/locals/")));
+            Assert::IsTrue(str.StartsWith(String("key=")));
+            Assert::IsTrue(str.EndsWith(String("value2")));
+            Assert::IsTrue(str.EndsWith('2'));
+            Assert::IsFalse(str.StartsWith(String("key=value; path=/usr/local/bin; key2=value2+")));
+            Assert::IsFalse(String().StartsWith('k'));
+            Assert::ExpectException<ArgumentOutOfRangeException>([&str]() { str.IndexOf('=', str.Length() + 1); });
+
+            // Random text over a small alphabet, so that candidates are frequent and needles repeat themselves.
+            srand(17);
+
+            for(int round = 0; round < 200; ++round)
+            {
+                char text[300];
+                const int length = rand() % 300;
+                const int alphabet = 2 + rand() % 3;
+
+                for(int i = 0; i < length; ++i)
+                {
+                    text[i] = static_cast<char>('a' + rand() % alphabet);
+                }
+
+                const String haystack(text, length);
+                const int needleLength = 1 + rand() % 40;
+                char needle[40];
+
+                for(int i = 0; i < needleLength; ++i)
+                {
+                    needle[i] = static_cast<char>('a' + rand() % alphabet);
+                }
+
+                const String value(needle, needleLength);
+                const String present = length > needleLength ? String(text + length / 3, needleLength) : value;
+
+                Assert::AreEqual(NaiveIndexOf(haystack, value), haystack.IndexOf(value));
+                Assert::AreEqual(NaiveIndexOf(haystack, present), haystack.IndexOf(present));
+                Assert::AreEqual(NaiveLastIndexOf(haystack, value), haystack.LastIndexOf(value));
+                Assert::AreEqual(NaiveLastIndexOf(haystack, present), haystack.LastIndexOf(present));
+            }
+
+            // Candidates that keep failing late hand the search over to Two-Way.
+            String repeated(std::string(5000, 'a').c_str());
+            String late((std::string(100, 'a') + "b").c_str());
+            String periodic((std::string(3000, 'a') + "ab" + std::string(2000, 'a')).c_str());
+
+            Assert::AreEqual(-1, repeated.IndexOf(late));
+            Assert::AreEqual(2900, String((std::string(3000, 'a') + "b").c_str()).IndexOf(late));
+            Assert::AreEqual(2951, periodic.IndexOf(String((std::string(50, 'a') + "b" + std::string(50, 'a')).c_str())));
+        }
+
+        TEST_METHOD(Segments)
+        {
+            String payload("GET /api/v1/items?id=42 HTTP/1.1");
+            AllocationCounter counter;
+
+            // Slicing, comparing, hashing and searching segments doesn't allocate.
+            StringSegment request(payload);
+            const int firstSpace = request.IndexOf(' ');
+            StringSegment method = request.Subsegment(0, firstSpace);
+            StringSegment target = request.Subsegment(firstSpace + 1, request.LastIndexOf(' ') - firstSpace - 1);
+            StringSegment query = target.Subsegment(target.IndexOf('?') + 1);
+
+            Assert::AreEqual(0, counter.Count());
+            Assert::IsTrue(method == String("GET"));
+            Assert::AreEqual(4, target.Offset());
+            Assert::AreEqual(String("/api/v1/items?id=42").GetHashCode(), target.GetHashCode());
+            Assert::AreEqual(payload.GetHashCode(), request.GetHashCode());
+            Assert::IsTrue(query.StartsWith(String("id=")));
+            Assert::IsTrue(payload.Contains(query));
+            Assert::IsTrue(payload.EndsWith(request.Subsegment(request.Length() - 3)));
+            Assert::AreEqual(4, payload.IndexOf(target));
+            Assert::IsTrue(StringSegment::CompareOrdinal(method, target) > 0);
+
+            // A segment keeps the buffer it was taken from alive.
+            StringSegment kept;
+
+            {
+                String temporary("a temporary string on the heap");
+
+                kept = StringSegment(temporary, 2, 9);
+            }
+
+            Assert::IsTrue(kept.ToString() == "temporary");
+            Assert::IsTrue(String("temporary").Equals(kept));
+
+            // Borrowed segments reference the caller's characters.
+            const utf16char chars[] = { 'k', 'e', 'y' };
+            StringSegment borrowed(chars, 3);
+            StringBuilder builder;
+
+            builder.Append(borrowed).Append(StringSegment(payload, 3, 5));
+
+            Assert::IsTrue(builder.ToString() == "key /api");
+            Assert::IsTrue(borrowed.Equals(String("key")));
+            Assert::IsTrue(kept.Buffer().Length() > 0);
+            Assert::AreEqual(0, borrowed.Buffer().Length());
+            Assert::ExpectException<ArgumentOutOfRangeException>([&payload]() { StringSegment(payload, 30, 5); });
+        }
+
+        static std::string Join(StringSplitEnumerator enumerator)
+        {
+            std::string joined;
+
+            while(enumerator.MoveNext())
+            {
+                joined += '[';
+
+                for(int i = 0; i < enumerator.Current().Length(); ++i)
+                {
+                    joined += static_cast<char>(enumerator.Current()[i]);
+                }
+
+                joined += ']';
+            }
+
+            return joined;
+        }
+
+        TEST_METHOD(Split)
+        {
+            String csv("id, name ,,price,");
+            const utf16char separators[] = { ',', ';' };
+
+            Assert::AreEqual(std::string("[id][ name ][][price][]"), Join(csv.Split(',')));
+            Assert::AreEqual(std::string("[id][ name ][price]"), Join(csv.Split(',', StringSplitOptions::RemoveEmptyEntries)));
+            Assert::AreEqual(std::string("[id][name][][price][]"), Join(csv.Split(',', StringSplitOptions::TrimEntries)));
+            Assert::AreEqual(std::string("[id][name][price]"), Join(csv.Split(',', StringSplitOptions::RemoveEmptyEntries | StringSplitOptions::TrimEntries)));
+            Assert::AreEqual(std::string("[a][b][c][]"), Join(String("a;b,c;").Split(separators, 2)));
+            Assert::AreEqual(std::string("[a][b][c]"), Join(String(" a\tb  c").Split(separators, 0, StringSplitOptions::RemoveEmptyEntries)));
+            Assert::AreEqual(std::string("[key][value][x]"), Join(String("key::value::x").Split(String("::"))));
+            Assert::AreEqual(std::string("[key::value]"), Join(String("key::value").Split(String())));
+            Assert::AreEqual(std::string("[]"), Join(String().Split(',')));
+            Assert::AreEqual(std::string(""), Join(String().Split(',', StringSplitOptions::RemoveEmptyEntries)));
+
+            // Entries are segments of the source, enumerating them doesn't allocate.
+            String line("timestamp=1700000000;level=warning;component=network;message=connection reset");
+            AllocationCounter counter;
+            StringSplitEnumerator fields = line.Split(';');
+            int count = 0;
+
+            while(fields.MoveNext())
+            {
+                StringSplitEnumerator pair = fields.Current().Split('=');
+
+                Assert::IsTrue(pair.MoveNext());
+                Assert::IsTrue(pair.MoveNext());
+                Assert::IsFalse(pair.MoveNext());
+                ++count;
+            }
+
+            Assert::AreEqual(4, count);
+            Assert::AreEqual(0, counter.Count());
+
+            // The eager form counts the entries first and fills an exactly sized array.
+            Array<String> entries = csv.Split(',', StringSplitOptions::RemoveEmptyEntries | StringSplitOptions::TrimEntries).ToArray();
+
+            Assert::AreEqual(static_cast<int64_t>(3), entries.Length());
+            Assert::IsTrue(entries[2] == "price");
+        }
+
+        TEST_METHOD(ConcatAndJoin)
+        {
+            String name("temperature");
+            const utf16char unit[] = { 0xB0, 'C', 0 };
+            const char *missing = nullptr;
+
+            Assert::IsTrue(String::Concat() == "");
+            Assert::IsTrue(String::Concat(name) == "temperature");
+            Assert::IsTrue(String::Concat(name, '=', 21.5, unit, missing) == String::Concat("temperature=21.5", StringSegment(unit, 2)));
+            Assert::IsTrue(String::Concat(-42, ' ', 4000000000u, ' ', INT64_MIN, ' ', true) == "-42 4000000000 -9223372036854775808 True");
+            Assert::IsTrue(String::Concat(0.1, ' ', 1e20, ' ', 0.1f, ' ', -0.0) == "0.1 1E+20 0.1 -0");
+            Assert::IsTrue(String::Concat(name, StringSegment(name, 0, 4), "\xE9") == String::Concat("temperaturetemp", static_cast<utf16char>(0xE9)));
+
+            // The result is allocated once, at its final length.
+            {
+                String key("sensor");
+                AllocationCounter counter;
+                String line = String::Concat(key, '[', 17, "].value = ", 3.25, " (", name, ')');
+
+                Assert::AreEqual(1, counter.Count());
+                Assert::IsTrue(line == "sensor[17].value = 3.25 (temperature)");
+            }
+
+            std::vector<String> columns = { String("id"), String("name"), String(), String("price") };
+            const int values[] = { 1, -20, 300 };
+
+            Assert::IsTrue(String::Join(", ", columns) == "id, name, , price");
+            Assert::IsTrue(String::Join('|', values) == "1|-20|300");
+            Assert::IsTrue(String::Join(String("::"), columns.begin(), columns.begin() + 2) == "id::name");
+            Assert::IsTrue(String::Join(',', columns.begin(), columns.begin() + 1) == "id");
+            Assert::IsTrue(String::Join(',', columns.begin(), columns.begin()) == "");
+        }
+
+        TEST_METHOD(Literals)
+        {
+            static StringLiteral literal(u"a literal in static storage");
+            AllocationCounter counter;
+            String str(literal);
+            String copy = str;
+            String shortLiteral(u"short");
+            auto typeName = []() { return DNN_STRING("System.Collections.Generic"); };
+            String macro = typeName();
+
+            // Literals share their static characters and are never copied to the heap.
+            Assert::IsTrue(static_cast<const utf16char*>(copy) == static_cast<const utf16char*>(String(literal)));
+            Assert::IsTrue(static_cast<const utf16char*>(macro) == static_cast<const utf16char*>(typeName()));
+            Assert::IsTrue(Object().ToString() == "System.Object");
+            Assert::AreEqual(0, counter.Count());
+
+            Assert::IsTrue(str == "a literal in static storage");
+            Assert::AreEqual(27, copy.Length());
+            Assert::IsTrue(shortLiteral == "short");
+            Assert::IsTrue(Environment::NewLine == "\r\n");
+            Assert::AreEqual(String("System.Collections.Generic").GetHashCode(), macro.GetHashCode());
+            Assert::IsTrue(String::Intern(macro).Equals(macro));
+        }
+
+        // Converts the code points one by one, for comparison with the vectorized conversion.
+        static std::u16string ToUpperReference(const std::u16string &str)
+        {
+            std::u16string upper = str;
+
+            for(size_t i = 0; i < upper.size(); ++i)
+            {
+                if(i + 1 < upper.size() && Char::IsSurrogatePair(upper[i], upper[i + 1]))
+                {
+                    const int codePoint = CharUnicodeInfo::ToUpper(Char::ConvertToUtf32(upper[i], upper[i + 1])) - 0x10000;
+
+                    upper[i] = static_cast<char16_t>(0xD800 + (codePoint >> 10));
+                    upper[++i] = static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF));
+                }
+                else
+                {
+                    upper[i] = Char::ToUpperInvariant(upper[i]);
+                }
+            }
+
+            return upper;
+        }
+
+        TEST_METHOD(CaseConversion)
+        {
+            Assert::AreEqual<int>('A', Char::ToUpperInvariant('a'));
+            Assert::AreEqual<int>('z', Char::ToLowerInvariant('Z'));
+            Assert::AreEqual<int>('1', Char::ToUpperInvariant('1'));
+            Assert::AreEqual<int>(0xC9, Char::ToUpperInvariant(0xE9));
+            Assert::AreEqual<int>(0x178, Char::ToUpperInvariant(0xFF));
+            Assert::AreEqual<int>(0xDF, Char::ToUpperInvariant(0xDF));
+            Assert::AreEqual<int>(0xDF, Char::ToLowerInvariant(0x1E9E));
+            Assert::AreEqual<int>(0x3A3, Char::ToUpperInvariant(0x3C2));
+            Assert::AreEqual<int>(0x1C4, Char::ToUpperInvariant(0x1C5));
+            Assert::AreEqual<int>(0x1C6, Char::ToLowerInvariant(0x1C5));
+            Assert::AreEqual<int>(0x2D00, Char::ToLowerInvariant(0x10A0));
+            Assert::AreEqual<int>(0x131, Char::ToUpperInvariant(0x131));
+            Assert::AreEqual<int>(0x130, Char::ToLowerInvariant(0x130));
+            Assert::AreEqual<int>(0xD801, Char::ToLowerInvariant(0xD801));
+            Assert::AreEqual(0x10428, CharUnicodeInfo::ToLower(0x10400));
+            Assert::AreEqual(0x1E900, CharUnicodeInfo::ToUpper(0x1E922));
+
+            String header("Content-Type: Application/JSON; charset=UTF-8");
+
+            Assert::IsTrue(header.ToLowerInvariant() == "content-type: application/json; charset=utf-8");
+            Assert::IsTrue(header.ToUpperInvariant() == "CONTENT-TYPE: APPLICATION/JSON; CHARSET=UTF-8");
+            Assert::IsTrue(String("short").ToUpperInvariant() == "SHORT");
+
+            // Strings that don't change are returned as they are.
+            String lower("already lowercase, and long enough to be on the heap");
+            String upper = lower.ToUpperInvariant();
+
+            Assert::IsTrue(static_cast<const utf16char*>(lower.ToLowerInvariant()) == static_cast<const utf16char*>(lower));
+            Assert::IsTrue(static_cast<const utf16char*>(upper.ToUpperInvariant()) == static_cast<const utf16char*>(upper));
+            Assert::IsTrue(upper.ToLowerInvariant() == lower);
+
+            // Non-ASCII characters and surrogate pairs, also across the vectors.
+            const std::u16string greek = u"Stra\u00DFe \u03C3\u03AF\u03C3\u03C5\u03C6\u03BF\u03C2 1234567 \U00010428\U00010429";
+            String str(reinterpret_cast<const utf16char*>(greek.c_str()));
+
+            Assert::IsTrue(str.ToUpperInvariant() == reinterpret_cast<const utf16char*>(u"STRA\u00DFE \u03A3\u038A\u03A3\u03A5\u03A6\u039F\u03A3 1234567 \U00010400\U00010401"));
+            Assert::IsTrue(str.ToUpperInvariant().ToLowerInvariant() == reinterpret_cast<const utf16char*>(u"stra\u00DFe \u03C3\u03AF\u03C3\u03C5\u03C6\u03BF\u03C3 1234567 \U00010428\U00010429"));
+
+            // Random mixes of ASCII, Latin-1, Greek, Cyrillic, surrogate pairs and unpaired surrogates.
+            const char16_t pool[] = { u'a', u'Q', u'z', u'-', u'7', 0xE0, 0xC0, 0xFF, 0x3B1, 0x391, 0x430, 0x410, 0x131, 0x130, 0xD801, 0xDC28, 0xDC00 };
+
+            srand(23);
+
+            for(int round = 0; round < 500; ++round)
+            {
+                std::u16string text;
+                const int length = rand() % 70;
+                const bool ascii = rand() % 2 == 0;
+
+                for(int i = 0; i < length; ++i)
+                {
+                    text += ascii ? static_cast<char16_t>(' ' + rand() % 95) : pool[rand() % (sizeof(pool) / sizeof(pool[0]))];
+                }
+
+                String original(reinterpret_cast<const utf16char*>(text.data()), length);
+                const std::u16string expected = ToUpperReference(text);
+                String converted = original.ToUpperInvariant();
+
+                Assert::AreEqual(length, converted.Length());
+                Assert::IsTrue(memcmp(expected.data(), static_cast<const utf16char*>(converted), sizeof(char16_t) * length) == 0);
+
+                if(length > 11)
+                {
+                    Assert::AreEqual(expected == text, static_cast<const utf16char*>(converted) == static_cast<const utf16char*>(original));
+                }
+            }
+        }
+
+        TEST_METHOD(Comparers)
+        {
+            const shared_ptr<StringComparer> &ordinal = StringComparer::Ordinal();
+            const shared_ptr<StringComparer> &ignoreCase = StringComparer::OrdinalIgnoreCase();
+
+            Assert::IsTrue(ordinal->Equals(String("Key"), String("Key")));
+            Assert::IsFalse(ordinal->Equals(String("Key"), String("KEY")));
+            Assert::IsTrue(ignoreCase->Equals(String("Key"), String("kEY")));
+            Assert::IsFalse(ignoreCase->Equals(String("Key"), String("Keys")));
+            Assert::IsFalse(ignoreCase->Equals(String("Key["), String("Key{")));
+            Assert::IsTrue(ignoreCase->Equals(String(reinterpret_cast<const utf16char*>(u"\u00E9t\u00E9")), String(reinterpret_cast<const utf16char*>(u"\u00C9T\u00C9"))));
+            Assert::AreEqual(ignoreCase->GetHashCode(String("content-type")), ignoreCase->GetHashCode(String("Content-Type")));
+
+            // Lookups with either comparer don't allocate.
+            Collections::Dictionary<String, int> headers(ignoreCase);
+            String contentType("content-type");
+            String contentLength("content-length");
+            String userAgent("user-agent: a name that is too long to be stored inline");
+
+            headers.Add(String("Content-Type"), 1);
+            headers.Add(String("USER-AGENT: A name that is too long to be stored inline"), 2);
+
+            Assert::IsTrue(headers.Comparer().get() == ignoreCase.get());
+            Assert::IsTrue(headers.ContainsKey(String("CONTENT-TYPE")));
+
+            {
+                AllocationCounter counter;
+
+                Assert::AreEqual(1, headers[contentType]);
+                Assert::AreEqual(2, headers[userAgent]);
+                Assert::IsFalse(headers.ContainsKey(contentLength));
+                Assert::AreEqual(ordinal->GetHashCode(userAgent), userAgent.GetHashCode());
+                Assert::AreEqual(0, counter.Count());
+            }
+
+            // Random strings and copies of them with the case of a character changed or another character, across the chunks hashed at
+            // a time. The hash code is the one of the string converted to upper case.
+            const char16_t pool[] = { u'a', u'Q', u'z', u'-', u'7', 0xE0, 0xC0, 0xFF, 0x3B1, 0x391, 0x430, 0x410, 0x131, 0x130, 0xD801, 0xDC28, 0xDC00 };
+
+            srand(29);
+
+            for(int round = 0; round < 500; ++round)
+            {
+                std::u16string text;
+                const int length = rand() % 150;
+                const bool ascii = rand() % 2 == 0;
+
+                for(int i = 0; i < length; ++i)
+                {
+                    text += ascii ? static_cast<char16_t>(' ' + rand() % 95) : pool[rand() % (sizeof(pool) / sizeof(pool[0]))];
+                }
+
+                std::u16string changed = text;
+
+                if(length > 0)
+                {
+                    const int index = rand() % length;
+
+                    const int change = rand() % 3;
+
+                    if(change == 0)
+                    {
+                        changed[index] = static_cast<char16_t>(Char::ToUpperInvariant(changed[index]));
+                    }
+                    else if(change == 1)
+                    {
+                        changed[index] = static_cast<char16_t>(Char::ToLowerInvariant(changed[index]));
+                    }
+                    else
+                    {
+                        changed[index] = pool[rand() % (sizeof(pool) / sizeof(pool[0]))];
+                    }
+                }
+
+                String original(reinterpret_cast<const utf16char*>(text.data()), length);
+                String other(reinterpret_cast<const utf16char*>(changed.data()), length);
+                const bool equal = ToUpperReference(text) == ToUpperReference(changed);
+
+                Assert::AreEqual(equal, ignoreCase->Equals(original, other));
+                Assert::AreEqual(original.ToUpperInvariant().GetHashCode(), ignoreCase->GetHashCode(original));
+
+                if(equal)
+                {
+                    Assert::AreEqual(ignoreCase->GetHashCode(original), ignoreCase->GetHashCode(other));
+                }
+            }
+        }
+
+        TEST_METHOD(Trim)
+        {
+            String padded(" \t key = value \r\n");
+
+            Assert::IsTrue(padded.Trim() == "key = value");
+            Assert::IsTrue(padded.TrimStart() == "key = value \r\n");
+            Assert::IsTrue(padded.TrimEnd() == " \t key = value");
+            Assert::IsTrue(String("--name--").Trim('-') == "name");
+            Assert::IsTrue(String("--name--").TrimEnd('-') == "--name");
+            Assert::IsTrue(String("[(name)]").Trim(reinterpret_cast<const utf16char*>(u"[]()"), 4) == "name");
+            Assert::IsTrue(String("  name  ").Trim(nullptr, 0) == "name");
+            Assert::IsTrue(String("    ").Trim().Length() == 0);
+            Assert::IsTrue(String().Trim().Length() == 0);
+
+            // Strings with nothing to remove are returned as they are.
+            String trimmed("a string long enough to be on the heap");
+
+            Assert::IsTrue(static_cast<const utf16char*>(trimmed.Trim()) == static_cast<const utf16char*>(trimmed));
+            Assert::IsTrue(static_cast<const utf16char*>(trimmed.TrimEnd('x')) == static_cast<const utf16char*>(trimmed));
+
+            // White space outside ASCII, also between runs of ASCII white space long enough to fill vectors.
+            const std::u16string unicode = u"\u00A0\u2003                    \u0085text\u3000                   ";
+
+            Assert::IsTrue(String(reinterpret_cast<const utf16char*>(unicode.c_str())).Trim() == "text");
+            Assert::IsTrue(String::IsNullOrWhiteSpace(String(reinterpret_cast<const utf16char*>(u"\t\u00A0                   \u2028"))));
+            Assert::IsFalse(String::IsNullOrWhiteSpace(String(reinterpret_cast<const utf16char*>(u"                  \u200B"))));
+            Assert::IsTrue(String::IsNullOrWhiteSpace(String()));
+
+            StringSegment segment(String("(  inner text  )"), 1, 15);
+
+            Assert::IsTrue(segment.TrimEnd() == "  inner text  )");
+            Assert::IsTrue(segment.Subsegment(0, segment.Length() - 1).Trim() == "inner text");
+            Assert::IsTrue(segment.TrimStart().Offset() == 3);
+
+            // Random mixes of white space and other characters against a scan with Char::IsWhiteSpace.
+            const char16_t pool[] = { u' ', u'\t', u'\n', u'\r', 0x0B, 0x0C, 0x85, 0xA0, 0x2000, 0x3000, u'a', 0x08, 0x0E, 0x1F, 0xE9, 0x200B, 0x8020 };
+
+            srand(31);
+
+            for(int round = 0; round < 500; ++round)
+            {
+                std::u16string text;
+                const int length = rand() % 70;
+
+                for(int i = 0; i < length; ++i)
+                {
+                    text += rand() % 4 != 0 ? pool[rand() % 6] : pool[rand() % (sizeof(pool) / sizeof(pool[0]))];
+                }
+
+                int start = 0;
+                int end = length;
+
+                while(start < length && Char::IsWhiteSpace(text[start]))
+                {
+                    ++start;
+                }
+
+                while(end > start && Char::IsWhiteSpace(text[end - 1]))
+                {
+                    --end;
+                }
+
+                String str(reinterpret_cast<const utf16char*>(text.data()), length);
+                String expected(reinterpret_cast<const utf16char*>(text.data()) + start, end - start);
+
+                Assert::IsTrue(str.Trim() == expected);
+                Assert::AreEqual(length - start, str.TrimStart().Length());
+                Assert::AreEqual(start == length ? 0 : end, str.TrimEnd().Length());
+                Assert::AreEqual(String::IsNullOrWhiteSpace(str), start == length);
+            }
+        }
+
+        TEST_METHOD(Intern)
+        {
+            String first("protocol.header.content-type");
+            String second("protocol.header.content-type");
+            String interned = String::Intern(first);
+
+            Assert::AreEqual(0, first.AtomId());
+            Assert::AreNotEqual(0, interned.AtomId());
+            Assert::IsTrue(interned == first);
+            Assert::IsTrue(String::IsInterned(second));
+            Assert::IsFalse(String::IsInterned(String("protocol.header.not-interned")));
+
+            // Every interned copy shares the canonical buffer, which is not the one it was interned from.
+            String again = String::Intern(second);
+
+            Assert::AreEqual(interned.AtomId(), again.AtomId());
+            Assert::IsTrue(static_cast<const utf16char*>(interned) == static_cast<const utf16char*>(again));
+            Assert::IsTrue(static_cast<const utf16char*>(interned) != static_cast<const utf16char*>(first));
+            Assert::IsTrue(static_cast<const utf16char*>(String::FromAtomId(interned.AtomId())) == static_cast<const utf16char*>(interned));
+
+            String shortString = String::Intern(String("id"));
+            String copy(shortString);
+
+            Assert::AreEqual(shortString.AtomId(), copy.AtomId());
+            Assert::AreEqual(shortString.AtomId(), String::Intern(String("id")).AtomId());
+            Assert::IsFalse(shortString == interned);
+            Assert::IsTrue(String::FromAtomId(shortString.AtomId()) == "id");
+            Assert::ExpectException<ArgumentOutOfRangeException>([]() { String::FromAtomId(0); });
+
+            // Interned strings outlive the arena they were interned in.
+            String fromArena;
+
+            {
+                Memory::ArenaScope scope;
+
+                fromArena = String::Intern(String("allocated.in.an.arena"));
+            }
+
+            Assert::IsTrue(fromArena == "allocated.in.an.arena");
+        }
+
+        TEST_METHOD(Latin1Storage)
+        {
+            // 96 characters that all fit a byte, and the same with the last one outside Latin-1.
+            char text[97];
+            utf16char wide[97];
+
+            for(int i = 0; i < 96; ++i)
+            {
+                text[i] = static_cast<char>(i % 8 == 7 ? 0xE9 : 'a' + i % 26);
+                wide[i] = static_cast<uint8_t>(text[i]);
+            }
+
+            text[96] = 0;
+            wide[96] = 0;
+
+            int latin1Bytes;
+            int utf16Bytes;
+
+            {
+                AllocationCounter counter;
+                String fromChars(text);
+
+                latin1Bytes = counter.Bytes();
+
+                // Wide characters are stored a byte each as well when they all fit.
+                String fromWide(wide, 96);
+
+                Assert::AreEqual(latin1Bytes * 2, counter.Bytes());
+
+                wide[95] = 0x100;
+
+                String notLatin1(wide, 96);
+
+                utf16Bytes = counter.Bytes() - latin1Bytes * 2;
+                wide[95] = static_cast<uint8_t>(text[95]);
+            }
+
+            Assert::IsTrue(latin1Bytes * 10 < utf16Bytes * 6);
+
+            // A StringBuilder makes a UTF-16 string with the same characters.
+            String latin1(text);
+            String utf16 = StringBuilder(wide, 96).ToString();
+
+            Assert::IsTrue(latin1 == utf16);
+            Assert::IsTrue(utf16.Equals(latin1));
+            Assert::IsTrue(latin1 == text);
+            Assert::IsTrue(latin1 == wide);
+            Assert::AreEqual(0, String::CompareOrdinal(latin1, utf16));
+            Assert::AreEqual(utf16.GetHashCode(), latin1.GetHashCode());
+            Assert::AreEqual(static_cast<utf16char>(0xE9), latin1[7]);
+
+            wide[95] = 0x100;
+
+            const String greater(wide, 96);
+
+            wide[95] = static_cast<uint8_t>(text[95]);
+
+            Assert::IsTrue(String::CompareOrdinal(latin1, greater) < 0);
+            Assert::IsTrue(String::CompareOrdinal(greater, latin1) > 0);
+            Assert::IsFalse(latin1 == greater);
+
+            // Pointers to the characters are widened once and stay valid with the string.
+            const utf16char *chars = latin1;
+
+            Assert::IsTrue(chars == static_cast<const utf16char*>(String(latin1)));
+            Assert::IsTrue(memcmp(chars, wide, sizeof(wide)) == 0);
+
+            // Searches give the same results on either representation.
+            const String needles[] = { String("\xE9"), String("hij\xE9"), String("abcdefg\xE9ijklmn"), String(u"\u0100"), String(u"g\u00E9i"), StringBuilder("opq\xE9stuvw\xE9yzab", 14).ToString() };
+
+            for(const String &needle : needles)
+            {
+                Assert::AreEqual(utf16.IndexOf(needle), latin1.IndexOf(needle));
+                Assert::AreEqual(utf16.IndexOf(needle, 40), latin1.IndexOf(needle, 40));
+                Assert::AreEqual(utf16.LastIndexOf(needle), latin1.LastIndexOf(needle));
+                Assert::AreEqual(utf16.StartsWith(needle), latin1.StartsWith(needle));
+                Assert::AreEqual(utf16.EndsWith(needle), latin1.EndsWith(needle));
+                Assert::AreEqual(utf16.IndexOf(StringSegment(needle)), latin1.IndexOf(StringSegment(needle)));
+            }
+
+            Assert::AreEqual(utf16.IndexOf(latin1), latin1.IndexOf(utf16));
+            Assert::AreEqual(71, latin1.IndexOf(static_cast<utf16char>(0xE9), 64));
+            Assert::AreEqual(95, latin1.LastIndexOf(static_cast<utf16char>(0xE9)));
+            Assert::AreEqual(-1, latin1.IndexOf(static_cast<utf16char>(0x1E9)));
+            Assert::AreEqual(-1, latin1.LastIndexOf(static_cast<utf16char>(0x1E9)));
+
+            const utf16char anyOf[] = { 0x1E9, 'z', 0xE9 };
+
+            Assert::AreEqual(utf16.IndexOfAny(anyOf, 3), latin1.IndexOfAny(anyOf, 3));
+            Assert::AreEqual(utf16.IndexOfAny(anyOf, 1), latin1.IndexOfAny(anyOf, 1));
+            Assert::IsTrue(latin1.StartsWith('a') && latin1.EndsWith(static_cast<utf16char>(0xE9)));
+            Assert::IsTrue(StringSegment(latin1) == utf16);
+            Assert::IsTrue(StringSegment(utf16) == latin1);
+
+            int entries = 0;
+
+            for(StringSplitEnumerator split = latin1.Split(static_cast<utf16char>(0xE9)); split.MoveNext(); ++entries)
+            {
+                Assert::AreEqual(entries < 12 ? 7 : 0, split.Current().Length());
+            }
+
+            Assert::AreEqual(13, entries);
+
+            // Trimmed and converted strings stay a byte per character when they can.
+            const String padded("\xA0  \t caf\xE9 cr\xE8me br\xFBl\xE9" "e \x85\r\n");
+            const String trimmed = padded.Trim();
+
+            Assert::IsTrue(trimmed == "caf\xE9 cr\xE8me br\xFBl\xE9" "e");
+            Assert::IsTrue(padded.TrimStart() == "caf\xE9 cr\xE8me br\xFBl\xE9" "e \x85\r\n");
+            Assert::IsTrue(padded.TrimEnd(reinterpret_cast<const utf16char*>(u"\n\r\u0085 "), 4) == "\xA0  \t caf\xE9 cr\xE8me br\xFBl\xE9" "e");
+            Assert::IsTrue(String::IsNullOrWhiteSpace(String("\xA0 \x85\t\r\n\xA0 \x85\t\r\n\xA0 \x85\t\r\n")));
+            Assert::IsFalse(String::IsNullOrWhiteSpace(String("\xA0 \x85\t\r\n\xA0 \x85\t\r\n\xA0 \x85\t\r\n.")));
+
+            const String upper = latin1.ToUpperInvariant();
+
+            Assert::IsTrue(upper == utf16.ToUpperInvariant());
+            Assert::IsTrue(upper.ToLowerInvariant() == latin1);
+            Assert::IsTrue(String("stra\xDF" "e m\xFC" "de \xFF").ToUpperInvariant() == reinterpret_cast<const utf16char*>(u"STRA\u00DFE M\u00DCDE \u0178"));
+            Assert::IsTrue(String("\xB5-meter \xE0 l'\xE9t\xE9").ToUpperInvariant() == reinterpret_cast<const utf16char*>(u"\u039C-METER \u00C0 L'\u00C9T\u00C9"));
+            Assert::IsTrue(String("ALREADY UPPER \xC9").ToUpperInvariant() == "ALREADY UPPER \xC9");
+
+            const shared_ptr<StringComparer> &ignoreCase = StringComparer::OrdinalIgnoreCase();
+
+            Assert::IsTrue(ignoreCase->Equals(latin1, upper));
+            Assert::IsTrue(ignoreCase->Equals(upper, utf16));
+            Assert::IsFalse(ignoreCase->Equals(latin1, greater));
+            Assert::AreEqual(upper.GetHashCode(), ignoreCase->GetHashCode(latin1));
+            Assert::AreEqual(ignoreCase->GetHashCode(utf16), ignoreCase->GetHashCode(latin1));
+
+            // Concatenation, building and interning.
+            const String joined = String::Join(", ", std::vector<String>{ trimmed, latin1, String("id") });
+
+            Assert::IsTrue(joined == String::Concat(trimmed, ", ", utf16, ", ", "id"));
+            Assert::IsTrue(String::Concat(trimmed, static_cast<utf16char>(0x100)) == StringBuilder(trimmed).Append(static_cast<utf16char>(0x100)).ToString());
+            Assert::IsTrue(StringBuilder(latin1).Append(latin1).ToString() == String::Concat(utf16, utf16));
+
+            const String interned = String::Intern(latin1);
+
+            Assert::AreEqual(interned.AtomId(), String::Intern(utf16).AtomId());
+            Assert::IsTrue(interned == utf16);
+
+            utf16char enumerated[97] = {};
+            int count = 0;
+            unique_ptr<Collections::IEnumerator<utf16char>> enumerator = latin1.GetEnumerator();
+
+            while(enumerator->MoveNext())
+            {
+                enumerated[count++] = enumerator->Current();
+            }
+
+            Assert::IsTrue(memcmp(enumerated, wide, sizeof(wide)) == 0);
+        }
     };
 }
\ No newline at end of file